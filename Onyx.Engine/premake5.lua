@@ -32,13 +32,27 @@ project "Onyx.Engine"
 	links {
 		"Glad",
 		"GLFW",
-		"imgui",
-		"opengl32.lib"
+		"imgui"
 	}
 
 	filter "system:windows"
 		systemversion "latest"
 		defines "GLFW_INCLUDE_NONE"
+		links "opengl32.lib"
+
+	filter "system:linux"
+		pic "On"
+		defines "GLFW_INCLUDE_NONE"
+		links {
+			"GL",
+			"EGL",
+			"X11",
+			"dl",
+			"pthread"
+		}
+
+	filter "options:memory-tracking"
+		defines "ONYX_MEMORY_TRACKING=1"
 
 	filter "configurations:Debug"
 		defines "ONYX_DEBUG"
@@ -5,10 +5,27 @@
 //
 
 #include "Onyx/Application.h"
+#include "Onyx/Assets/AssetManager.h"
+#include "Onyx/Debug/BinaryLog.h"
+#include "Onyx/Debug/MemoryTracker.h"
+#include "Onyx/Debug/Profiler.h"
 #include "Onyx/ImGuiLayer.h"
 #include "Onyx/Input.h"
+#include "Onyx/Jobs/JobSystem.h"
 #include "Onyx/Layer.h"
 #include "Onyx/Log.h"
+#include "Onyx/Memory/FrameAllocator.h"
+#include "Onyx/Memory/HandlePool.h"
+#include "Onyx/Memory/LinearArena.h"
+#include "Onyx/Renderer/Buffer.h"
+#include "Onyx/Renderer/Mesh.h"
+#include "Onyx/Renderer/RenderCommand.h"
+#include "Onyx/Renderer/Renderer.h"
+#include "Onyx/Renderer/Renderer2D.h"
+#include "Onyx/Renderer/Shader.h"
+#include "Onyx/Renderer/Texture.h"
+#include "Onyx/Renderer/VertexArray.h"
+#include "Onyx/Timestep.h"
 
 //
 
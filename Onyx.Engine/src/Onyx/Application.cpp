@@ -2,113 +2,257 @@
 
 #include "Application.h"
 
-#include <glad/glad.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 
+#include "Onyx/Debug/BinaryLog.h"
+#include "Onyx/Debug/MemoryTracker.h"
+#include "Onyx/Debug/Profiler.h"
 #include "Onyx/Events/ApplicationEvent.h"
+#include "Onyx/Events/EventRecording.h"
+#include "Onyx/Input.h"
+#include "Onyx/Memory/FrameAllocator.h"
+#include "Onyx/Renderer/GPUProfiler.h"
+#include "Onyx/Renderer/RenderCommand.h"
+#include "Onyx/Renderer/Renderer.h"
+#include "Onyx/Renderer/Renderer2D.h"
 
 namespace Onyx {
 Application* Application::s_Application = nullptr;
 
-Application::Application() {
+Application::Application(const ApplicationSettings& settings) : m_Settings(settings) {
   OnyxAssert(s_Application == nullptr, "Application initialized more than once!");
+  m_StartTime = std::chrono::steady_clock::now();
   s_Application = this;
+  if (!std::isfinite(m_Settings.FixedUpdateRate) || m_Settings.FixedUpdateRate <= 0.0) {
+    const double rate = ApplicationSettings().FixedUpdateRate;
+    OnyxWarn("Invalid fixed update rate {}, using {} Hz", m_Settings.FixedUpdateRate, rate);
+    m_Settings.FixedUpdateRate = rate;
+  }
+  if (m_Settings.MaxFixedUpdatesPerFrame == 0) {
+    OnyxWarn("At least one fixed update per frame is needed to keep up");
+    m_Settings.MaxFixedUpdatesPerFrame = 1;
+  }
+  m_FixedTimestep = static_cast<float>(1.0 / m_Settings.FixedUpdateRate);
+  if (!m_Settings.BinaryLogPath.empty()) {
+    BinaryLog::Open(m_Settings.BinaryLogPath);
+  }
+  m_JobSystem = CreateScope<JobSystem>(m_Settings.JobWorkerCount);
 
   constexpr WindowProps props{"Onyx", 1600, 900};
   m_Window = CreateScope<Window>(props);
-  m_Window->SetCallback([this](const Event& e) { OnEvent(e); });
+  Shader::SetCacheDirectory(m_Settings.ShaderCacheDirectory);
+  Renderer::Init(m_Window->GetContext(), m_Settings.ThreadedRendering, m_Settings.FramesInFlight);
+  Renderer2D::Init();
+  m_AssetManager = CreateScope<AssetManager>(*m_JobSystem, m_Settings.AssetUploadBytesPerFrame,
+                                             m_Settings.AssetUploadMsPerFrame);
+  RebuildDispatcher();
 
-  m_ImGuiLayer = CreateRef<ImGuiLayer>();
+  m_ImGuiLayer = CreateRef<ImGuiLayer>(m_Settings.ImGuiFontCacheDirectory);
   PushOverlay(m_ImGuiLayer);
+}
 
-  glGenVertexArrays(1, &m_VAO);
-  glBindVertexArray(m_VAO);
+Application::~Application() {
+  // Layers may still submit graphics work while detaching, so they go before the renderer.
+  m_LayerStack.Clear();
+  m_AssetManager.reset();
+  Renderer2D::Shutdown();
+  Renderer::Shutdown();
+  ONYX_PROFILE_END_SESSION();
+  BinaryLog::Close();
+}
 
-  unsigned int vbo;
-  glGenBuffers(1, &vbo);
-  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+void Application::Run() {
+  ONYX_PROFILE_THREAD("Main");
+  m_Running = true;
 
-  float vertices[] = {-0.5f, -0.5f, 0.0f, 0.5f, -0.5f, 0.0f, 0.0f, 0.5f, 0.0f};
-  glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+#if ONYX_PROFILE
+  // Capture the first N frames, useful for automated benchmark runs.
+  if (const char* frames = std::getenv("ONYX_PROFILE_FRAMES")) {
+    ONYX_PROFILE_BEGIN_SESSION("Onyx", "OnyxProfile.json", std::atoi(frames));
+  }
+#endif
 
-  glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+  // Input can be recorded, or replayed in place of the window's, for sessions that have to be
+  // exactly repeatable. Both run every frame with the same fixed timestep.
+  Scope<EventRecorder> recorder;
+  Scope<EventPlayer> player;
+  double recordedFrameStep = 0.0;
+  if (const char* path = std::getenv("ONYX_REPLAY_INPUT")) {
+    player = CreateScope<EventPlayer>(path);
+    if (player->IsOpen()) {
+      recordedFrameStep = player->GetFrameStep();
+    } else {
+      player.reset();
+    }
+  } else if (const char* path = std::getenv("ONYX_RECORD_INPUT")) {
+    recordedFrameStep = 1.0 / m_Settings.InputRecordingFrameRate;
+    recorder = CreateScope<EventRecorder>(path, recordedFrameStep);
+  }
 
-  unsigned int ibo;
-  glGenBuffers(1, &ibo);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+  using Clock = std::chrono::steady_clock;
+  const double fixedStep = 1.0 / m_Settings.FixedUpdateRate;
+  double accumulator = 0.0;
+  // Dropped time is reported at most once a second, not on every frame that falls behind.
+  double droppedTime = 0.0;
+  Clock::time_point lastDropWarning;
+  Clock::time_point lastFrameTime = Clock::now();
+  bool firstFrame = true;
+  uint64_t frameIndex = 0;
 
-  unsigned int indices[] = {0, 1, 2};
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices, GL_STATIC_DRAW);
-}
+  RenderCommand::SetClearColor({0.1f, 0.1f, 0.1f, 1.0f});
+  while (m_Running) {
+    {
+      ONYX_PROFILE_SCOPE("Application::Frame");
 
-Application::~Application() {}
+      const Clock::time_point now = Clock::now();
+      double frameTime = std::chrono::duration<double>(now - lastFrameTime).count();
+      lastFrameTime = now;
+      if (recordedFrameStep > 0.0) {
+        frameTime = recordedFrameStep;
+      }
+      m_FrameTimestep = static_cast<float>(frameTime);
 
-void Application::Run() {
-  m_Running = true;
+      if (m_LayerStack.BeginFrame()) {
+        RebuildDispatcher();
+      }
 
-  glClearColor(0.1f, 0.1f, 0.1f, 1);
-  while (m_Running) {
-    glClear(GL_COLOR_BUFFER_BIT);
-    glBindVertexArray(m_VAO);
-    glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, nullptr);
+      // Everything received while polling at the end of the previous frame.
+      EventQueue& events = m_Window->GetEventQueue();
+      if (player) {
+        // Closing the window still works, everything else the window received is replaced.
+        bool closed = false;
+        events.Visit([&closed](const QueuedEvent& e) {
+          closed = closed || e.Type == EventType::WindowClosed;
+        });
+        events.Clear();
+        if (closed || !player->Play(frameIndex, events)) {
+          Close();
+        }
+      } else if (recorder) {
+        events.Visit([&](const QueuedEvent& e) { recorder->Record(frameIndex, e); });
+      }
+      {
+        ONYX_MEMORY_TAG(Events);
+        events.Dispatch([this](const auto& e) {
+          Input::OnEvent(e);
+          m_Dispatcher.Dispatch(e);
+        });
+        Input::EndFrame();
+      }
 
-    for (auto layer : m_Layers) {
-      layer->OnUpdate();
-    }
+      accumulator += frameTime;
+      unsigned int fixedUpdates = 0;
+      while (accumulator >= fixedStep && fixedUpdates < m_Settings.MaxFixedUpdatesPerFrame) {
+        ONYX_PROFILE_SCOPE("Layer::OnFixedUpdate");
+        ONYX_MEMORY_TAG(Layers);
+        m_LayerStack.OnFixedUpdate(m_FixedTimestep);
+        accumulator -= fixedStep;
+        fixedUpdates++;
+      }
+      if (accumulator >= fixedStep) {
+        // Too far behind to catch up this frame, let the simulation slow down instead.
+        const double remainder = std::fmod(accumulator, fixedStep);
+        droppedTime += accumulator - remainder;
+        accumulator = remainder;
+        if (now - lastDropWarning >= std::chrono::seconds(1)) {
+          OnyxWarn("Dropped {:.2f}ms of simulation time to keep up", droppedTime * 1000.0);
+          droppedTime = 0.0;
+          lastDropWarning = now;
+        }
+      }
+      m_InterpolationAlpha = static_cast<float>(accumulator / fixedStep);
+
+      Renderer2D::ResetStats();
+      {
+        ONYX_MEMORY_TAG(Assets);
+        m_AssetManager->Update();
+      }
 
-    m_ImGuiLayer->Begin();
-    for (auto layer : m_Layers) {
-      layer->OnImGuiRender();
+      {
+        ONYX_PROFILE_SCOPE("Layer::OnUpdate");
+        ONYX_MEMORY_TAG(Layers);
+        GPUPassScope pass("Scene");
+        RenderCommand::Clear();
+        m_LayerStack.OnUpdate(m_FrameTimestep);
+      }
+
+      m_ImGuiLayer->Begin();
+      {
+        ONYX_PROFILE_SCOPE("Layer::OnImGuiRender");
+        ONYX_MEMORY_TAG(Layers);
+        m_LayerStack.OnImGuiRender();
+      }
+      m_ImGuiLayer->End();
+
+      {
+        ONYX_MEMORY_TAG(Window);
+        m_Window->OnUpdate();
+      }
+      {
+        ONYX_MEMORY_TAG(Renderer);
+        Renderer::EndFrame();
+      }
+
+      if (firstFrame) {
+        // Layers attach and compile their shaders during the first frame, so this is the number
+        // to compare between a cold and a warm shader cache.
+        Renderer::Flush();
+        OnyxInfo("First frame ready {:.1f}ms after startup",
+                 std::chrono::duration<float, std::milli>(Clock::now() - m_StartTime).count());
+        firstFrame = false;
+      }
     }
-    m_ImGuiLayer->End();
 
-    m_Window->OnUpdate();
+    FrameAllocator::EndFrame();
+    ONYX_PROFILE_FRAME_END();
+    ONYX_MEMORY_FRAME_END();
+    frameIndex++;
+  }
+
+  if (recorder) {
+    recorder->Finish(frameIndex);
   }
 }
 
+void Application::Close() { m_Running = false; }
+
 void Application::OnEvent(const Event& e) {
-  switch (e.GetEventType()) {
-    case EventType::WindowClosed:
-      m_Running = false;
-      return;
-    case EventType::WindowResized:
-      auto evt = reinterpret_cast<const WindowResizedEvent&>(e);
-      glViewport(0, 0, evt.Width, evt.Height);
-      break;
-  }
+  ONYX_PROFILE_FUNCTION();
 
-  for (auto it = m_Layers.rbegin(); it != m_Layers.rend(); ++it) {
-    if ((*it)->OnEvent(e)) {
-      break;
-    }
-  }
+  m_Dispatcher.Dispatch(e);
 }
 
-void Application::PushLayer(Ref<Layer> layer) {
-  m_Layers.emplace(m_Layers.begin() + m_LayerInsertIndex, layer);
-  m_LayerInsertIndex++;
-  layer->OnAttach();
+bool Application::OnWindowClosed(const WindowClosedEvent& e) {
+  m_Running = false;
+  return true;
 }
 
-void Application::PushOverlay(Ref<Layer> overlay) {
-  m_Layers.emplace_back(overlay);
-  overlay->OnAttach();
+bool Application::OnWindowResized(const WindowResizedEvent& e) {
+  RenderCommand::SetViewport(0, 0, e.Width, e.Height);
+  return false;
 }
 
-void Application::PopOverlay(Ref<Layer> overlay) {
-  auto it = std::find(m_Layers.begin() + m_LayerInsertIndex, m_Layers.end(), overlay);
-  if (it != m_Layers.end()) {
-    overlay->OnDetach();
-    m_Layers.erase(it);
+// The engine's own handlers come first, then layers from the top of the stack down.
+void Application::RebuildDispatcher() {
+  m_Dispatcher.Clear();
+  m_Dispatcher.Subscribe<&Application::OnWindowClosed>(this);
+  m_Dispatcher.Subscribe<&Application::OnWindowResized>(this);
+  for (auto it = m_LayerStack.rbegin(); it != m_LayerStack.rend(); ++it) {
+    for (const EventSubscription& subscription : (*it)->GetSubscriptions()) {
+      m_Dispatcher.Subscribe(subscription);
+    }
   }
 }
 
-void Application::PopLayer(Ref<Layer> layer) {
-  auto it = std::find(m_Layers.begin(), m_Layers.begin() + m_LayerInsertIndex, layer);
-  if (it != m_Layers.end()) {
-    layer->OnDetach();
-    m_Layers.erase(it);
-    m_LayerInsertIndex--;
-  }
+void Application::PushLayer(Ref<Layer> layer) { m_LayerStack.PushLayer(std::move(layer)); }
+
+void Application::PushOverlay(Ref<Layer> overlay) {
+  m_LayerStack.PushOverlay(std::move(overlay));
 }
+
+void Application::PopOverlay(Ref<Layer> overlay) { m_LayerStack.PopOverlay(std::move(overlay)); }
+
+void Application::PopLayer(Ref<Layer> layer) { m_LayerStack.PopLayer(std::move(layer)); }
 }  // namespace Onyx
\ No newline at end of file
@@ -1,23 +1,67 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
-#include <vector>
+#include <string>
 
+#include "Onyx/Assets/AssetManager.h"
 #include "Onyx/Core.h"
+#include "Onyx/Events/ApplicationEvent.h"
 #include "Onyx/Events/Event.h"
+#include "Onyx/Events/EventDispatcher.h"
 #include "Onyx/ImGuiLayer.h"
+#include "Onyx/Jobs/JobSystem.h"
 #include "Onyx/Layer.h"
+#include "Onyx/LayerStack.h"
+#include "Onyx/Timestep.h"
 #include "Onyx/Window.h"
 
 namespace Onyx {
+struct ApplicationSettings {
+  // Rate, in Hz, at which Layer::OnFixedUpdate is called. Rates that aren't positive fall back to
+  // the default.
+  double FixedUpdateRate = 120.0;
+  // Upper bound on fixed updates in a single frame. When a frame takes longer than this many
+  // steps, the remaining time is dropped rather than letting the simulation fall further behind.
+  unsigned int MaxFixedUpdatesPerFrame = 8;
+  // Job worker threads to start. Zero starts one per hardware thread besides the main thread.
+  unsigned int JobWorkerCount = 0;
+  // Execute graphics commands on a dedicated render thread instead of the main thread.
+  bool ThreadedRendering = false;
+  // How many recorded frames the main thread may get ahead of the render thread.
+  unsigned int FramesInFlight = 1;
+  // Where linked shader programs are cached between runs. Empty disables the cache.
+  std::string ShaderCacheDirectory = "cache/shaders";
+  // Where messages from the binary log macros are written. Empty leaves them disabled. The file is
+  // never rotated, so it grows for as long as the application runs.
+  std::string BinaryLogPath;
+  // Frame rate a session recorded with ONYX_RECORD_INPUT runs at. Recording and replaying both
+  // advance every frame by exactly this step, whatever the wall clock says.
+  double InputRecordingFrameRate = 60.0;
+  // Where baked ImGui font atlases are cached between runs. Empty disables the cache.
+  std::string ImGuiFontCacheDirectory = "cache/fonts";
+  // How much decoded asset data is handed to the GPU per frame, and for how long. The first
+  // upload of a frame always goes ahead, even if it is larger than the budget.
+  uint64_t AssetUploadBytesPerFrame = 16 * 1024 * 1024;
+  float AssetUploadMsPerFrame = 2.0f;
+};
+
 class Application {
  public:
-  ONYX_API Application();
+  ONYX_API Application(const ApplicationSettings& settings = ApplicationSettings());
   ONYX_API virtual ~Application();
 
   ONYX_API void Run();
+  ONYX_API void Close();
   ONYX_API void OnEvent(const Event& e);
   ONYX_API Scope<Window>& GetWindow() { return m_Window; }
+  ONYX_API Timestep GetFrameTimestep() const { return m_FrameTimestep; }
+  ONYX_API Timestep GetFixedTimestep() const { return m_FixedTimestep; }
+  // How far the current frame lies between the last two fixed updates, in the range [0, 1).
+  ONYX_API float GetInterpolationAlpha() const { return m_InterpolationAlpha; }
+  ONYX_API const LayerStack& GetLayerStack() const { return m_LayerStack; }
+  ONYX_API JobSystem& GetJobSystem() { return *m_JobSystem; }
+  ONYX_API AssetManager& GetAssetManager() { return *m_AssetManager; }
 
   static ONYX_API Application& Get() { return *s_Application; }
 
@@ -28,12 +72,23 @@ class Application {
   ONYX_API void PopLayer(Ref<Layer> layer);
 
  private:
+  bool OnWindowClosed(const WindowClosedEvent& e);
+  bool OnWindowResized(const WindowResizedEvent& e);
+  void RebuildDispatcher();
+
+  ApplicationSettings m_Settings;
+  std::chrono::steady_clock::time_point m_StartTime;
+  // Declared first so layers can still wait on jobs while they are detached.
+  Scope<JobSystem> m_JobSystem;
   Scope<Window> m_Window;
+  Scope<AssetManager> m_AssetManager;
   bool m_Running = false;
-  std::vector<Ref<Layer>> m_Layers;
+  Timestep m_FrameTimestep;
+  Timestep m_FixedTimestep;
+  float m_InterpolationAlpha = 0.0f;
+  LayerStack m_LayerStack;
+  EventDispatcher m_Dispatcher;
   Ref<ImGuiLayer> m_ImGuiLayer;
-  unsigned int m_LayerInsertIndex = 0;
-  unsigned int m_VAO = 0;
 
   static Application* s_Application;
 };
@@ -0,0 +1,250 @@
+#include "pch.h"
+
+#include "AssetManager.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include "Onyx/Assets/ImageDecoder.h"
+#include "Onyx/Assets/MeshDecoder.h"
+#include "Onyx/Debug/Profiler.h"
+
+namespace Onyx {
+// A file on its way from disk to the GPU. Owned by the decoding job until it is pushed to
+// m_Decoded, then by the upload queue.
+struct AssetLoad {
+  AssetHandle Handle;
+  AssetType Type = AssetType::Texture;
+  std::string Path;
+  bool Succeeded = false;
+  ImageData Image;
+  MeshData Geometry;
+
+  uint64_t GetSize() const {
+    return Type == AssetType::Texture ? Image.Pixels.size() : Geometry.GetSize();
+  }
+};
+
+// FNV-1a over the type and the path, so the same file loaded as two types gets two assets.
+static uint64_t HashAssetKey(AssetType type, const std::string& path) {
+  uint64_t hash = (14695981039346656037ull ^ static_cast<uint8_t>(type)) * 1099511628211ull;
+  for (const char c : path) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+static bool ReadFile(const std::string& path, std::vector<char>& contents) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    OnyxError("Failed to open asset {}", path);
+    return false;
+  }
+  contents.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  if (!file.read(contents.data(), static_cast<std::streamsize>(contents.size()))) {
+    OnyxError("Failed to read asset {}", path);
+    return false;
+  }
+  return true;
+}
+
+AssetManager::AssetManager(JobSystem& jobSystem, uint64_t uploadBytesPerFrame,
+                           float uploadMsPerFrame)
+    : m_JobSystem(jobSystem),
+      m_UploadBytesPerFrame(uploadBytesPerFrame),
+      m_UploadMsPerFrame(uploadMsPerFrame) {}
+
+AssetManager::~AssetManager() {
+  m_JobSystem.Wait(m_DecodeCounter);
+  for (AssetLoad* load : m_Decoded) {
+    delete load;
+  }
+}
+
+AssetHandle AssetManager::LoadTexture(const std::string& path) {
+  return Load(AssetType::Texture, path);
+}
+
+AssetHandle AssetManager::LoadMesh(const std::string& path) { return Load(AssetType::Mesh, path); }
+
+AssetHandle AssetManager::Load(AssetType type, const std::string& path) {
+  ONYX_PROFILE_FUNCTION();
+
+  // "a/../b.tga" and "b.tga" are the same file.
+  const std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+  const uint64_t key = HashAssetKey(type, normalized);
+
+  auto it = m_AssetsByKey.find(key);
+  if (it != m_AssetsByKey.end()) {
+    Asset* shared = m_Assets.Get(it->second);
+    if (shared->Path == normalized) {
+      shared->RefCount++;
+      return it->second;
+    }
+    OnyxWarn("Asset {} collides with {}, it will not be shared", normalized, shared->Path);
+  }
+
+  const AssetHandle handle = m_Assets.Create();
+  Asset& asset = *m_Assets.Get(handle);
+  asset.RefCount = 1;
+  asset.Type = type;
+  asset.State = AssetState::Decoding;
+  asset.Key = key;
+  asset.Path = normalized;
+  if (it == m_AssetsByKey.end()) {
+    m_AssetsByKey.emplace(key, handle);
+  }
+
+  auto* load = new AssetLoad();
+  load->Handle = handle;
+  load->Type = type;
+  load->Path = normalized;
+  m_JobSystem.Run([this, load]() { Decode(load); }, &m_DecodeCounter);
+  return load->Handle;
+}
+
+void AssetManager::Retain(AssetHandle handle) {
+  Asset* asset = m_Assets.Get(handle);
+  OnyxAssert(asset, "Retaining an asset that has been released!");
+  if (asset) {
+    asset->RefCount++;
+  }
+}
+
+void AssetManager::Release(AssetHandle handle) {
+  Asset* asset = m_Assets.Get(handle);
+  OnyxAssert(asset, "Releasing an asset that has been released!");
+  if (!asset || --asset->RefCount > 0) {
+    return;
+  }
+
+  // A load still in flight finds its handle stale once it reaches Update and is dropped.
+  auto it = m_AssetsByKey.find(asset->Key);
+  if (it != m_AssetsByKey.end() && it->second == handle) {
+    m_AssetsByKey.erase(it);
+  }
+  m_Assets.Release(handle);
+}
+
+AssetState AssetManager::GetState(AssetHandle handle) const {
+  const Asset* asset = m_Assets.Get(handle);
+  return asset ? asset->State : AssetState::Invalid;
+}
+
+Ref<Texture2D> AssetManager::GetTexture(AssetHandle handle) const {
+  const Asset* asset = m_Assets.Get(handle);
+  return asset ? asset->Texture : nullptr;
+}
+
+Ref<Mesh> AssetManager::GetMesh(AssetHandle handle) const {
+  const Asset* asset = m_Assets.Get(handle);
+  return asset ? asset->Geometry : nullptr;
+}
+
+void AssetManager::Update() {
+  ONYX_PROFILE_FUNCTION();
+
+  {
+    std::lock_guard<std::mutex> lock(m_DecodedMutex);
+    for (AssetLoad* load : m_Decoded) {
+      if (Asset* asset = m_Assets.Get(load->Handle)) {
+        asset->State = AssetState::Queued;
+      }
+      m_UploadQueue.emplace_back(load);
+    }
+    m_Decoded.clear();
+  }
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  m_Stats.UploadedAssets = 0;
+  m_Stats.UploadedBytes = 0;
+  m_Stats.UploadMs = 0.0f;
+  while (!m_UploadQueue.empty()) {
+    AssetLoad& load = *m_UploadQueue.front();
+    Asset* asset = m_Assets.Get(load.Handle);
+    if (asset && !load.Succeeded) {
+      asset->State = AssetState::Failed;
+      // Loading the path again retries it as a new asset instead of sharing this one.
+      auto it = m_AssetsByKey.find(asset->Key);
+      if (it != m_AssetsByKey.end() && it->second == load.Handle) {
+        m_AssetsByKey.erase(it);
+      }
+    } else if (asset) {
+      // The first upload of a frame always goes ahead, so assets larger than the whole budget
+      // still make it through, one per frame.
+      const uint64_t size = load.GetSize();
+      if (m_Stats.UploadedAssets > 0 &&
+          (m_Stats.UploadedBytes + size > m_UploadBytesPerFrame ||
+           m_Stats.UploadMs >= m_UploadMsPerFrame)) {
+        break;
+      }
+
+      Upload(*asset, load);
+      m_Stats.UploadedAssets++;
+      m_Stats.UploadedBytes += size;
+      m_Stats.UploadMs = std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
+    m_UploadQueue.pop_front();
+  }
+
+  m_Stats.Resident = 0;
+  m_Stats.Decoding = 0;
+  m_Stats.Queued = 0;
+  m_Stats.ResidentBytes = 0;
+  for (const Asset& asset : m_Assets) {
+    switch (asset.State) {
+      case AssetState::Decoding:
+        m_Stats.Decoding++;
+        break;
+      case AssetState::Queued:
+        m_Stats.Queued++;
+        break;
+      case AssetState::Ready:
+        m_Stats.Resident++;
+        m_Stats.ResidentBytes += asset.Size;
+        break;
+      case AssetState::Invalid:
+      case AssetState::Failed:
+        break;
+    }
+  }
+}
+
+// Creating the objects only records their graphics work; it runs on the render thread with the
+// rest of the frame, which is what the budget keeps in check.
+void AssetManager::Upload(Asset& asset, AssetLoad& load) {
+  ONYX_PROFILE_FUNCTION();
+
+  if (load.Type == AssetType::Texture) {
+    asset.Texture = Texture2D::Create(load.Image.Width, load.Image.Height);
+    asset.Texture->SetData(load.Image.Pixels.data(),
+                           static_cast<uint32_t>(load.Image.Pixels.size()));
+  } else {
+    asset.Geometry = Mesh::Create(load.Geometry);
+  }
+  asset.State = AssetState::Ready;
+  asset.Size = load.GetSize();
+}
+
+void AssetManager::Decode(AssetLoad* load) {
+  ONYX_PROFILE_FUNCTION();
+
+  std::vector<char> contents;
+  if (ReadFile(load->Path, contents)) {
+    if (load->Type == AssetType::Texture) {
+      load->Succeeded =
+          ImageDecoder::Decode(load->Path, reinterpret_cast<const unsigned char*>(contents.data()),
+                               contents.size(), load->Image);
+    } else {
+      load->Succeeded =
+          MeshDecoder::Decode(load->Path, contents.data(), contents.size(), load->Geometry);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(m_DecodedMutex);
+  m_Decoded.push_back(load);
+}
+}  // namespace Onyx
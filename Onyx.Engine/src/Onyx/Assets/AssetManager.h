@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Jobs/JobSystem.h"
+#include "Onyx/Memory/HandlePool.h"
+#include "Onyx/Renderer/Mesh.h"
+#include "Onyx/Renderer/Texture.h"
+
+namespace Onyx {
+enum class AssetType : uint8_t { Texture, Mesh };
+
+enum class AssetState : uint8_t {
+  Invalid,   // The handle was never loaded or has been released.
+  Decoding,  // Being read and decoded on a worker thread.
+  Queued,    // Decoded, waiting for its turn to upload.
+  Ready,
+  Failed,
+};
+
+// What the AssetManager keeps for every asset it holds. Only the AssetManager touches it.
+struct Asset {
+  uint32_t RefCount = 0;
+  AssetType Type = AssetType::Texture;
+  AssetState State = AssetState::Invalid;
+  uint64_t Key = 0;
+  uint64_t Size = 0;
+  std::string Path;
+  Ref<Texture2D> Texture;
+  Ref<Mesh> Geometry;
+};
+
+// Refers to an asset owned by the AssetManager. A stale handle never resolves to whatever asset
+// reuses its slot.
+using AssetHandle = Handle<Asset>;
+
+struct AssetLoad;
+
+// Loads textures and meshes without stalling the frame. Files are read and decoded on the job
+// system, and decoded assets are handed to the GPU from Update, at most a budgeted number of bytes
+// and milliseconds per frame. Loading the same file twice shares one asset, which stays resident
+// for as long as it has references. Used from the main thread only.
+class ONYX_API AssetManager final {
+ public:
+  struct Statistics {
+    uint32_t Resident = 0;
+    uint32_t Decoding = 0;
+    uint32_t Queued = 0;
+    uint64_t ResidentBytes = 0;
+    // Work done by the last Update.
+    uint32_t UploadedAssets = 0;
+    uint64_t UploadedBytes = 0;
+    float UploadMs = 0.0f;
+  };
+
+  AssetManager(JobSystem& jobSystem, uint64_t uploadBytesPerFrame, float uploadMsPerFrame);
+  ~AssetManager();
+
+  AssetManager(const AssetManager&) = delete;
+  AssetManager& operator=(const AssetManager&) = delete;
+
+  // Takes a reference to the asset at path, starting to load it unless it is already loaded.
+  // Returns right away; poll GetState or just draw with whatever GetTexture returns meanwhile.
+  AssetHandle LoadTexture(const std::string& path);
+  AssetHandle LoadMesh(const std::string& path);
+  void Retain(AssetHandle handle);
+  // Drops a reference. The last one frees the asset, or discards it if it is still loading.
+  void Release(AssetHandle handle);
+
+  AssetState GetState(AssetHandle handle) const;
+  // nullptr until the asset is Ready, or if the handle refers to another type of asset.
+  Ref<Texture2D> GetTexture(AssetHandle handle) const;
+  Ref<Mesh> GetMesh(AssetHandle handle) const;
+
+  // Uploads decoded assets within the frame budget, oldest first. The application calls this
+  // once per frame before updating layers.
+  void Update();
+
+  const Statistics& GetStats() const { return m_Stats; }
+
+ private:
+  AssetHandle Load(AssetType type, const std::string& path);
+  void Upload(Asset& asset, AssetLoad& load);
+
+  // Runs on a worker thread.
+  void Decode(AssetLoad* load);
+
+  JobSystem& m_JobSystem;
+  uint64_t m_UploadBytesPerFrame;
+  float m_UploadMsPerFrame;
+
+  HandlePool<Asset> m_Assets;
+  // Hash of the asset type and normalized path, to the asset holding it.
+  std::unordered_map<uint64_t, AssetHandle> m_AssetsByKey;
+
+  JobCounter m_DecodeCounter;
+  // Finished decodes, pushed by workers and collected by Update.
+  std::mutex m_DecodedMutex;
+  std::vector<AssetLoad*> m_Decoded;
+  std::deque<Scope<AssetLoad>> m_UploadQueue;
+
+  Statistics m_Stats;
+};
+}  // namespace Onyx
@@ -0,0 +1,218 @@
+#include "pch.h"
+
+#include "ImageDecoder.h"
+
+#include <cctype>
+#include <cstring>
+
+namespace Onyx {
+static uint16_t ReadU16(const unsigned char* bytes) {
+  return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+static uint32_t ReadU32(const unsigned char* bytes) {
+  return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+         (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+static bool HasExtension(const std::string& path, const char* extension) {
+  const size_t length = std::strlen(extension);
+  if (path.size() < length) {
+    return false;
+  }
+  for (size_t i = 0; i < length; ++i) {
+    const char c = path[path.size() - length + i];
+    if (std::tolower(static_cast<unsigned char>(c)) != extension[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ImageDecoder::Decode(const std::string& path, const unsigned char* bytes, size_t size,
+                          ImageData& image) {
+  if (size >= 2 && bytes[0] == 'B' && bytes[1] == 'M') {
+    return DecodeBMP(path, bytes, size, image);
+  }
+  // TGA has no signature to go by.
+  if (HasExtension(path, ".tga")) {
+    return DecodeTGA(path, bytes, size, image);
+  }
+
+  OnyxError("Image {} is not a BMP or TGA file", path);
+  return false;
+}
+
+bool ImageDecoder::DecodeBMP(const std::string& path, const unsigned char* bytes, size_t size,
+                             ImageData& image) {
+  constexpr size_t FileHeaderSize = 14;
+  constexpr size_t InfoHeaderSize = 40;
+  constexpr uint32_t CompressionNone = 0;
+  constexpr uint32_t CompressionBitFields = 3;
+
+  if (size < FileHeaderSize + InfoHeaderSize) {
+    OnyxError("Image {} is truncated", path);
+    return false;
+  }
+
+  const uint32_t pixelOffset = ReadU32(bytes + 10);
+  const auto width = static_cast<int32_t>(ReadU32(bytes + 18));
+  const auto height = static_cast<int32_t>(ReadU32(bytes + 22));
+  const uint16_t bitsPerPixel = ReadU16(bytes + 28);
+  const uint32_t compression = ReadU32(bytes + 30);
+
+  // Bit fields are accepted as long as they describe the usual BGRA order.
+  const bool bitFields = compression == CompressionBitFields && bitsPerPixel == 32 &&
+                         size >= FileHeaderSize + InfoHeaderSize + 12 &&
+                         ReadU32(bytes + 54) == 0x00ff0000 && ReadU32(bytes + 58) == 0x0000ff00 &&
+                         ReadU32(bytes + 62) == 0x000000ff;
+  if ((compression != CompressionNone && !bitFields) ||
+      (bitsPerPixel != 24 && bitsPerPixel != 32)) {
+    OnyxError("Image {} uses an unsupported BMP format ({} bpp, compression {})", path,
+              bitsPerPixel, compression);
+    return false;
+  }
+  if (width <= 0 || height == 0) {
+    OnyxError("Image {} has invalid dimensions", path);
+    return false;
+  }
+
+  // Rows are stored bottom up unless the height is negative, and padded to four bytes.
+  const bool topDown = height < 0;
+  image.Width = static_cast<uint32_t>(width);
+  image.Height = static_cast<uint32_t>(topDown ? -static_cast<int64_t>(height) : height);
+  const uint32_t channels = bitsPerPixel / 8;
+  const size_t stride = (static_cast<size_t>(image.Width) * channels + 3) & ~size_t(3);
+  if (pixelOffset > size || (size - pixelOffset) / stride < image.Height) {
+    OnyxError("Image {} is truncated", path);
+    return false;
+  }
+
+  image.Pixels.resize(static_cast<size_t>(image.Width) * image.Height * 4);
+  for (uint32_t y = 0; y < image.Height; ++y) {
+    const uint32_t row = topDown ? image.Height - 1 - y : y;
+    const unsigned char* src = bytes + pixelOffset + row * stride;
+    unsigned char* dst = image.Pixels.data() + static_cast<size_t>(y) * image.Width * 4;
+    for (uint32_t x = 0; x < image.Width; ++x, src += channels, dst += 4) {
+      dst[0] = src[2];
+      dst[1] = src[1];
+      dst[2] = src[0];
+      // 32 bit files without bit fields often leave alpha at zero, so only trust it with them.
+      dst[3] = bitFields ? src[3] : 0xff;
+    }
+  }
+  return true;
+}
+
+bool ImageDecoder::DecodeTGA(const std::string& path, const unsigned char* bytes, size_t size,
+                             ImageData& image) {
+  constexpr size_t HeaderSize = 18;
+  constexpr uint8_t TypeTrueColor = 2;
+  constexpr uint8_t TypeGrayscale = 3;
+  constexpr uint8_t RunLengthEncoded = 8;
+  constexpr uint8_t TopToBottom = 0x20;
+
+  if (size < HeaderSize) {
+    OnyxError("Image {} is truncated", path);
+    return false;
+  }
+
+  const uint8_t idLength = bytes[0];
+  const uint8_t colorMapType = bytes[1];
+  const uint8_t imageType = bytes[2];
+  const uint16_t colorMapLength = ReadU16(bytes + 5);
+  const uint8_t colorMapEntrySize = bytes[7];
+  image.Width = ReadU16(bytes + 12);
+  image.Height = ReadU16(bytes + 14);
+  const uint8_t bitsPerPixel = bytes[16];
+  const uint8_t descriptor = bytes[17];
+
+  const uint8_t baseType = imageType & ~RunLengthEncoded;
+  const bool grayscale = baseType == TypeGrayscale && bitsPerPixel == 8;
+  const bool trueColor = baseType == TypeTrueColor && (bitsPerPixel == 24 || bitsPerPixel == 32);
+  if (!grayscale && !trueColor) {
+    OnyxError("Image {} uses an unsupported TGA format (type {}, {} bpp)", path, imageType,
+              bitsPerPixel);
+    return false;
+  }
+  if (image.Width == 0 || image.Height == 0) {
+    OnyxError("Image {} has invalid dimensions", path);
+    return false;
+  }
+
+  // A color map may be present even when the image doesn't use it.
+  size_t offset = HeaderSize + idLength;
+  if (colorMapType != 0) {
+    offset += colorMapLength * ((colorMapEntrySize + 7) / 8);
+  }
+
+  const uint32_t channels = bitsPerPixel / 8;
+  const size_t pixelCount = static_cast<size_t>(image.Width) * image.Height;
+  auto readPixel = [&](unsigned char* dst) {
+    const unsigned char* src = bytes + offset;
+    if (grayscale) {
+      dst[0] = dst[1] = dst[2] = src[0];
+      dst[3] = 0xff;
+    } else {
+      dst[0] = src[2];
+      dst[1] = src[1];
+      dst[2] = src[0];
+      dst[3] = channels == 4 ? src[3] : 0xff;
+    }
+    offset += channels;
+  };
+
+  image.Pixels.resize(pixelCount * 4);
+  unsigned char* dst = image.Pixels.data();
+  if (imageType & RunLengthEncoded) {
+    size_t pixel = 0;
+    while (pixel < pixelCount) {
+      if (offset >= size) {
+        OnyxError("Image {} is truncated", path);
+        return false;
+      }
+      const uint8_t packet = bytes[offset++];
+      const size_t count = std::min<size_t>((packet & 0x7f) + 1, pixelCount - pixel);
+      const bool repeated = packet & 0x80;
+      if (size - offset < (repeated ? 1 : count) * channels) {
+        OnyxError("Image {} is truncated", path);
+        return false;
+      }
+
+      if (repeated) {
+        readPixel(dst + pixel * 4);
+        for (size_t i = 1; i < count; ++i) {
+          std::memcpy(dst + (pixel + i) * 4, dst + pixel * 4, 4);
+        }
+      } else {
+        for (size_t i = 0; i < count; ++i) {
+          readPixel(dst + (pixel + i) * 4);
+        }
+      }
+      pixel += count;
+    }
+  } else {
+    if (offset > size || (size - offset) / channels < pixelCount) {
+      OnyxError("Image {} is truncated", path);
+      return false;
+    }
+    for (size_t pixel = 0; pixel < pixelCount; ++pixel) {
+      readPixel(dst + pixel * 4);
+    }
+  }
+
+  // Files are bottom up by default, which is what the texture expects.
+  if (descriptor & TopToBottom) {
+    const size_t stride = static_cast<size_t>(image.Width) * 4;
+    std::vector<unsigned char> row(stride);
+    for (uint32_t y = 0; y < image.Height / 2; ++y) {
+      unsigned char* top = dst + y * stride;
+      unsigned char* bottom = dst + (image.Height - 1 - y) * stride;
+      std::memcpy(row.data(), top, stride);
+      std::memcpy(top, bottom, stride);
+      std::memcpy(bottom, row.data(), stride);
+    }
+  }
+  return true;
+}
+}  // namespace Onyx
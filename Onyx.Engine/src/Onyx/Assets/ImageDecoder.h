@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+// Tightly packed RGBA8 pixels, rows from the bottom up as Texture2D::SetData expects.
+struct ImageData {
+  uint32_t Width = 0;
+  uint32_t Height = 0;
+  std::vector<unsigned char> Pixels;
+};
+
+// Decodes uncompressed 24 and 32 bit BMP files, and TGA files that are true color or grayscale,
+// raw or run-length encoded. Safe to call from any thread. Returns false, leaving image in an
+// unspecified state, if the file is malformed or uses a format that isn't supported.
+class ONYX_API ImageDecoder final {
+ public:
+  static bool Decode(const std::string& path, const unsigned char* bytes, size_t size,
+                     ImageData& image);
+
+ private:
+  static bool DecodeBMP(const std::string& path, const unsigned char* bytes, size_t size,
+                        ImageData& image);
+  static bool DecodeTGA(const std::string& path, const unsigned char* bytes, size_t size,
+                        ImageData& image);
+};
+}  // namespace Onyx
@@ -0,0 +1,138 @@
+#include "pch.h"
+
+#include "MeshDecoder.h"
+
+#include <charconv>
+
+namespace Onyx {
+struct ObjIndex {
+  int Position = 0;
+  int TexCoord = 0;
+  int Normal = 0;
+
+  bool operator==(const ObjIndex& other) const {
+    return Position == other.Position && TexCoord == other.TexCoord && Normal == other.Normal;
+  }
+};
+
+struct ObjIndexHash {
+  size_t operator()(const ObjIndex& index) const {
+    size_t hash = static_cast<size_t>(index.Position) * 73856093u;
+    hash ^= static_cast<size_t>(index.TexCoord) * 19349663u;
+    hash ^= static_cast<size_t>(index.Normal) * 83492791u;
+    return hash;
+  }
+};
+
+static const char* SkipSpaces(const char* it, const char* end) {
+  while (it < end && (*it == ' ' || *it == '\t')) {
+    it++;
+  }
+  return it;
+}
+
+// Parses up to count floats, leaving the rest at zero.
+static const char* ParseFloats(const char* it, const char* end, float* values, int count) {
+  for (int i = 0; i < count; ++i) {
+    it = SkipSpaces(it, end);
+    const std::from_chars_result result = std::from_chars(it, end, values[i]);
+    if (result.ec != std::errc()) {
+      break;
+    }
+    it = result.ptr;
+  }
+  return it;
+}
+
+// Resolves a one based, or negative and relative to the end, index to a zero based one. Returns
+// -1 for a missing index and -2 for one that is out of range.
+static int ResolveIndex(long index, size_t count) {
+  if (index == 0) {
+    return -1;
+  }
+  const long resolved = index > 0 ? index - 1 : static_cast<long>(count) + index;
+  return resolved >= 0 && static_cast<size_t>(resolved) < count ? static_cast<int>(resolved) : -2;
+}
+
+bool MeshDecoder::Decode(const std::string& path, const char* text, size_t size, MeshData& mesh) {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> normals;
+  std::vector<glm::vec2> texCoords;
+  std::unordered_map<ObjIndex, uint32_t, ObjIndexHash> vertices;
+  std::vector<uint32_t> face;
+
+  const char* it = text;
+  const char* const end = text + size;
+  uint32_t line = 0;
+  while (it < end) {
+    const char* lineEnd = it;
+    while (lineEnd < end && *lineEnd != '\n') {
+      lineEnd++;
+    }
+    line++;
+
+    it = SkipSpaces(it, lineEnd);
+    if (lineEnd - it >= 2 && it[0] == 'v' && (it[1] == ' ' || it[1] == '\t')) {
+      glm::vec3& position = positions.emplace_back(0.0f);
+      ParseFloats(it + 2, lineEnd, &position.x, 3);
+    } else if (lineEnd - it >= 3 && it[0] == 'v' && it[1] == 'n') {
+      glm::vec3& normal = normals.emplace_back(0.0f);
+      ParseFloats(it + 2, lineEnd, &normal.x, 3);
+    } else if (lineEnd - it >= 3 && it[0] == 'v' && it[1] == 't') {
+      glm::vec2& texCoord = texCoords.emplace_back(0.0f);
+      ParseFloats(it + 2, lineEnd, &texCoord.x, 2);
+    } else if (lineEnd - it >= 2 && it[0] == 'f' && (it[1] == ' ' || it[1] == '\t')) {
+      face.clear();
+      it += 2;
+      while ((it = SkipSpaces(it, lineEnd)) < lineEnd && *it != '\r' && *it != '#') {
+        // Each corner is v, v/vt, v//vn or v/vt/vn.
+        long raw[3] = {0, 0, 0};
+        for (int component = 0; component < 3; ++component) {
+          it = std::from_chars(it, lineEnd, raw[component]).ptr;
+          if (it >= lineEnd || *it != '/') {
+            break;
+          }
+          it++;
+        }
+
+        ObjIndex index;
+        index.Position = ResolveIndex(raw[0], positions.size());
+        index.TexCoord = ResolveIndex(raw[1], texCoords.size());
+        index.Normal = ResolveIndex(raw[2], normals.size());
+        if (index.Position < 0 || index.TexCoord == -2 || index.Normal == -2) {
+          OnyxError("Mesh {} has an invalid face index on line {}", path, line);
+          return false;
+        }
+
+        auto [vertex, inserted] =
+            vertices.try_emplace(index, static_cast<uint32_t>(mesh.Vertices.size()));
+        if (inserted) {
+          MeshVertex& corner = mesh.Vertices.emplace_back();
+          corner.Position = positions[index.Position];
+          corner.Normal = index.Normal >= 0 ? normals[index.Normal] : glm::vec3(0.0f);
+          corner.TexCoord = index.TexCoord >= 0 ? texCoords[index.TexCoord] : glm::vec2(0.0f);
+        }
+        face.push_back(vertex->second);
+      }
+
+      if (face.size() < 3) {
+        OnyxError("Mesh {} has a face with fewer than three corners on line {}", path, line);
+        return false;
+      }
+      for (size_t i = 2; i < face.size(); ++i) {
+        mesh.Indices.push_back(face[0]);
+        mesh.Indices.push_back(face[i - 1]);
+        mesh.Indices.push_back(face[i]);
+      }
+    }
+
+    it = lineEnd + 1;
+  }
+
+  if (mesh.Indices.empty()) {
+    OnyxError("Mesh {} has no faces", path);
+    return false;
+  }
+  return true;
+}
+}  // namespace Onyx
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Onyx/Core.h"
+#include "Onyx/Renderer/Mesh.h"
+
+namespace Onyx {
+// Decodes Wavefront OBJ files into a single indexed mesh. Polygons are triangulated as fans,
+// vertices that share a position, texture coordinate and normal are merged, and anything besides
+// geometry (materials, groups, smoothing) is ignored. Safe to call from any thread. Returns false
+// if the file is malformed.
+class ONYX_API MeshDecoder final {
+ public:
+  static bool Decode(const std::string& path, const char* text, size_t size, MeshData& mesh);
+};
+}  // namespace Onyx
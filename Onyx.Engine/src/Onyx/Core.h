@@ -1,15 +1,22 @@
 #pragma once
 
-#ifdef _WIN32
+#if defined(_WIN32)
 #define ONYX_PLATFORM_WINDOWS
+#elif defined(__linux__)
+#define ONYX_PLATFORM_LINUX
 #endif
 
-#ifdef ONYX_PLATFORM_WINDOWS
+#if defined(ONYX_PLATFORM_WINDOWS)
 #ifdef ONYX_BUILD_DLL
 #define ONYX_API __declspec(dllexport)
 #else
 #define ONYX_API __declspec(dllimport)
 #endif
+#define ONYX_DEBUGBREAK() __debugbreak()
+#elif defined(ONYX_PLATFORM_LINUX)
+#define ONYX_API __attribute__((visibility("default")))
+#include <signal.h>
+#define ONYX_DEBUGBREAK() raise(SIGTRAP)
 #else
 #error Unsupported platform!
 #endif
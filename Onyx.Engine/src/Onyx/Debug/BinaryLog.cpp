@@ -0,0 +1,237 @@
+#include "pch.h"
+
+#include "BinaryLog.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+namespace Onyx {
+// Single-producer, single-consumer byte ring holding u16-size-prefixed messages. The owning
+// thread advances Head, the log thread advances Tail.
+struct BinaryLogBuffer {
+  static constexpr uint64_t Capacity = 1 << 20;
+
+  unsigned char Bytes[Capacity];
+  std::atomic<uint64_t> Head{0};
+  std::atomic<uint64_t> Tail{0};
+  uint16_t ThreadIndex = 0;
+};
+
+struct BinaryLogSiteInfo {
+  int Level;
+  uint32_t Line;
+  const char* File;
+  const char* Format;
+  std::vector<BinaryArgType> Types;
+};
+
+struct BinaryLogData {
+  static constexpr std::chrono::milliseconds FlushInterval{20};
+
+  std::mutex Mutex;  // Guards everything below, never taken while writing a message.
+  std::vector<Scope<BinaryLogBuffer>> Buffers;
+  std::vector<BinaryLogSiteInfo> Sites;  // Indexed by id - 1.
+  size_t SitesWritten = 0;
+  std::ofstream Output;
+  std::string Path;
+  uint64_t MessagesWritten = 0;
+
+  std::atomic<bool> Active{false};
+  std::atomic<uint64_t> Dropped{0};
+  std::thread Thread;
+  std::condition_variable Wake;
+  bool Stopping = false;
+  std::chrono::steady_clock::time_point Epoch;
+};
+
+static BinaryLogData s_Data;
+static thread_local BinaryLogBuffer* s_ThreadBuffer = nullptr;
+
+static BinaryLogBuffer& GetThreadBuffer() {
+  if (!s_ThreadBuffer) {
+    std::lock_guard<std::mutex> lock(s_Data.Mutex);
+    auto buffer = CreateScope<BinaryLogBuffer>();
+    buffer->ThreadIndex = static_cast<uint16_t>(s_Data.Buffers.size());
+    s_ThreadBuffer = buffer.get();
+    s_Data.Buffers.emplace_back(std::move(buffer));
+  }
+
+  return *s_ThreadBuffer;
+}
+
+template <typename T>
+static void WriteValue(std::ofstream& out, T value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+static void WriteString(std::ofstream& out, const char* str) {
+  const auto length = static_cast<uint16_t>(std::min<size_t>(std::strlen(str), UINT16_MAX));
+  WriteValue(out, length);
+  out.write(str, length);
+}
+
+static void ReadRing(const BinaryLogBuffer& buffer, uint64_t position, void* dst, size_t size) {
+  const uint64_t offset = position & (BinaryLogBuffer::Capacity - 1);
+  const size_t first = std::min<size_t>(size, BinaryLogBuffer::Capacity - offset);
+  std::memcpy(dst, buffer.Bytes + offset, first);
+  std::memcpy(static_cast<unsigned char*>(dst) + first, buffer.Bytes, size - first);
+}
+
+// Must be called with the mutex held. Sites go first, so every message refers to a site that is
+// already in the file.
+static void DrainBuffers() {
+  std::ofstream& out = s_Data.Output;
+  for (; s_Data.SitesWritten < s_Data.Sites.size(); ++s_Data.SitesWritten) {
+    const BinaryLogSiteInfo& site = s_Data.Sites[s_Data.SitesWritten];
+    WriteValue(out, BinaryLogRecord::Site);
+    WriteValue(out, static_cast<uint32_t>(s_Data.SitesWritten + 1));
+    WriteValue(out, static_cast<uint8_t>(site.Level));
+    WriteValue(out, site.Line);
+    WriteValue(out, static_cast<uint8_t>(site.Types.size()));
+    out.write(reinterpret_cast<const char*>(site.Types.data()), site.Types.size());
+    WriteString(out, site.File);
+    WriteString(out, site.Format);
+  }
+
+  unsigned char message[BinaryLog::MaxMessageSize];
+  for (auto& buffer : s_Data.Buffers) {
+    uint64_t tail = buffer->Tail.load(std::memory_order_relaxed);
+    const uint64_t head = buffer->Head.load(std::memory_order_acquire);
+    while (tail != head) {
+      uint16_t size;
+      ReadRing(*buffer, tail, &size, sizeof(size));
+      ReadRing(*buffer, tail + sizeof(size), message, size);
+      tail += sizeof(size) + size;
+
+      WriteValue(out, BinaryLogRecord::Message);
+      WriteValue(out, buffer->ThreadIndex);
+      WriteValue(out, size);
+      out.write(reinterpret_cast<const char*>(message), size);
+      s_Data.MessagesWritten++;
+    }
+    buffer->Tail.store(head, std::memory_order_release);
+  }
+}
+
+static void DiscardBuffers() {
+  for (auto& buffer : s_Data.Buffers) {
+    buffer->Tail.store(buffer->Head.load(std::memory_order_acquire), std::memory_order_release);
+  }
+}
+
+static void LogThread() {
+  std::unique_lock<std::mutex> lock(s_Data.Mutex);
+  while (!s_Data.Stopping) {
+    s_Data.Wake.wait_for(lock, BinaryLogData::FlushInterval);
+    DrainBuffers();
+    s_Data.Output.flush();
+  }
+}
+
+bool BinaryLog::Open(const std::string& filepath) {
+  Close();
+
+  {
+    std::lock_guard<std::mutex> lock(s_Data.Mutex);
+    const std::filesystem::path parent = std::filesystem::path(filepath).parent_path();
+    if (!parent.empty()) {
+      std::error_code error;
+      std::filesystem::create_directories(parent, error);
+    }
+
+    s_Data.Output.open(filepath, std::ios::binary | std::ios::trunc);
+    if (!s_Data.Output.is_open()) {
+      OnyxError("Failed to open binary log '{}'", filepath);
+      return false;
+    }
+
+    WriteValue(s_Data.Output, BinaryLogMagic);
+    WriteValue(s_Data.Output, BinaryLogVersion);
+    // Sites registered for an earlier file have to be written to this one as well.
+    s_Data.SitesWritten = 0;
+    s_Data.MessagesWritten = 0;
+    s_Data.Path = filepath;
+    s_Data.Epoch = std::chrono::steady_clock::now();
+    s_Data.Stopping = false;
+    DiscardBuffers();
+  }
+
+  s_Data.Thread = std::thread(LogThread);
+  s_Data.Active.store(true, std::memory_order_release);
+  OnyxInfo("Writing binary log to '{}'", filepath);
+  return true;
+}
+
+void BinaryLog::Close() {
+  if (!s_Data.Active.exchange(false, std::memory_order_acq_rel)) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(s_Data.Mutex);
+    s_Data.Stopping = true;
+  }
+  s_Data.Wake.notify_one();
+  s_Data.Thread.join();
+
+  std::lock_guard<std::mutex> lock(s_Data.Mutex);
+  DrainBuffers();
+  s_Data.Output.close();
+  OnyxInfo("Binary log '{}' closed, {} messages written", s_Data.Path, s_Data.MessagesWritten);
+  if (const uint64_t dropped = s_Data.Dropped.exchange(0, std::memory_order_relaxed)) {
+    OnyxWarn("Binary log dropped {} messages", dropped);
+  }
+}
+
+bool BinaryLog::IsActive() { return s_Data.Active.load(std::memory_order_acquire); }
+
+uint64_t BinaryLog::GetDroppedMessages() { return s_Data.Dropped.load(std::memory_order_relaxed); }
+
+uint32_t BinaryLog::Register(BinaryLogSite& site, const char* format,
+                             std::initializer_list<BinaryArgType> types) {
+  std::lock_guard<std::mutex> lock(s_Data.Mutex);
+  // Another thread may have got here first.
+  uint32_t id = site.Id.load(std::memory_order_relaxed);
+  if (id == 0) {
+    s_Data.Sites.push_back({site.Level, site.Line, site.File, format, types});
+    id = static_cast<uint32_t>(s_Data.Sites.size());
+    site.Id.store(id, std::memory_order_release);
+  }
+
+  return id;
+}
+
+uint64_t BinaryLog::Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              s_Data.Epoch)
+      .count();
+}
+
+void BinaryLog::Push(const unsigned char* message, size_t size) {
+  BinaryLogBuffer& buffer = GetThreadBuffer();
+  const uint16_t length = static_cast<uint16_t>(size);
+  const uint64_t head = buffer.Head.load(std::memory_order_relaxed);
+  const uint64_t total = sizeof(length) + size;
+  if (head + total - buffer.Tail.load(std::memory_order_acquire) > BinaryLogBuffer::Capacity) {
+    Drop();
+    return;
+  }
+
+  unsigned char* bytes = buffer.Bytes;
+  auto write = [bytes](uint64_t position, const void* src, size_t count) {
+    const uint64_t offset = position & (BinaryLogBuffer::Capacity - 1);
+    const size_t first = std::min<size_t>(count, BinaryLogBuffer::Capacity - offset);
+    std::memcpy(bytes + offset, src, first);
+    std::memcpy(bytes, static_cast<const unsigned char*>(src) + first, count - first);
+  };
+  write(head, &length, sizeof(length));
+  write(head + sizeof(length), message, size);
+  buffer.Head.store(head + total, std::memory_order_release);
+}
+
+void BinaryLog::Drop() { s_Data.Dropped.fetch_add(1, std::memory_order_relaxed); }
+}  // namespace Onyx
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "Onyx/Core.h"
+#include "Onyx/Debug/BinaryLogFormat.h"
+#include "Onyx/Log.h"
+
+#ifndef ONYX_BINARY_LOG
+#define ONYX_BINARY_LOG 1
+#endif
+
+namespace Onyx {
+// A call site of the binary log macros, registered with the log the first time it is hit.
+struct BinaryLogSite {
+  int Level;
+  const char* File;
+  uint32_t Line;
+  std::atomic<uint32_t> Id{0};
+};
+
+namespace BinaryLogDetail {
+template <typename T>
+struct Unsupported : std::false_type {};
+
+template <typename T>
+constexpr BinaryArgType TypeOf() {
+  if constexpr (std::is_same_v<T, bool>) {
+    return BinaryArgType::Bool;
+  } else if constexpr (std::is_same_v<T, char>) {
+    return BinaryArgType::Char;
+  } else if constexpr (std::is_integral_v<T>) {
+    return std::is_signed_v<T> ? BinaryArgType::Int : BinaryArgType::UInt;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    return BinaryArgType::Float;
+  } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    return BinaryArgType::String;
+  } else if constexpr (std::is_pointer_v<T>) {
+    return BinaryArgType::Pointer;
+  } else {
+    static_assert(Unsupported<T>::value,
+                  "Binary log arguments must be numbers, strings or pointers");
+  }
+}
+
+template <typename T>
+size_t SizeOf(const T& value);
+
+template <typename T>
+void Encode(unsigned char*& out, const T& value);
+}  // namespace BinaryLogDetail
+
+// Logging for hot paths that is cheap enough to leave on in shipped builds. A message costs a
+// copy of its arguments into a per-thread ring; the format string is written to the file once per
+// call site and formatting is left to Onyx.LogDecoder. A background thread moves the rings to the
+// file, and messages are dropped when a ring is full.
+class ONYX_API BinaryLog final {
+ public:
+  // Longer string arguments are cut off.
+  static constexpr size_t MaxStringLength = 256;
+  static constexpr size_t MaxMessageSize = 2048;
+
+  static bool Open(const std::string& filepath);
+  static void Close();
+  static bool IsActive();
+  static uint64_t GetDroppedMessages();
+
+  template <typename... Args>
+  static void Write(BinaryLogSite& site, const char* format, const Args&... args) {
+    if (!IsActive()) {
+      return;
+    }
+
+    uint32_t id = site.Id.load(std::memory_order_acquire);
+    if (id == 0) {
+      id = Register(site, format, {BinaryLogDetail::TypeOf<std::decay_t<Args>>()...});
+    }
+
+    const size_t size =
+        sizeof(uint32_t) + sizeof(uint64_t) + (size_t(0) + ... + BinaryLogDetail::SizeOf(args));
+    if (size > MaxMessageSize) {
+      Drop();
+      return;
+    }
+
+    unsigned char message[MaxMessageSize];
+    const uint64_t timestamp = Now();
+    std::memcpy(message, &id, sizeof(id));
+    std::memcpy(message + sizeof(id), &timestamp, sizeof(timestamp));
+    [[maybe_unused]] unsigned char* out = message + sizeof(id) + sizeof(timestamp);
+    (BinaryLogDetail::Encode(out, args), ...);
+    Push(message, size);
+  }
+
+ private:
+  static uint32_t Register(BinaryLogSite& site, const char* format,
+                           std::initializer_list<BinaryArgType> types);
+  static uint64_t Now();
+  static void Push(const unsigned char* message, size_t size);
+  static void Drop();
+};
+
+namespace BinaryLogDetail {
+// A null C string is logged as an empty one.
+template <typename T>
+std::string_view AsString(const T& value) {
+  if constexpr (std::is_pointer_v<T>) {
+    return std::string_view(value ? value : "");
+  } else {
+    return value;
+  }
+}
+
+template <typename T>
+size_t SizeOf(const T& value) {
+  if constexpr (TypeOf<std::decay_t<T>>() == BinaryArgType::String) {
+    const std::string_view str = AsString(value);
+    return sizeof(uint16_t) + std::min(str.size(), BinaryLog::MaxStringLength);
+  } else if constexpr (TypeOf<std::decay_t<T>>() == BinaryArgType::Bool ||
+                       TypeOf<std::decay_t<T>>() == BinaryArgType::Char) {
+    return 1;
+  } else {
+    return 8;
+  }
+}
+
+template <typename T>
+void Encode(unsigned char*& out, const T& value) {
+  constexpr BinaryArgType type = TypeOf<std::decay_t<T>>();
+  if constexpr (type == BinaryArgType::String) {
+    const std::string_view str = AsString(value);
+    const auto length = static_cast<uint16_t>(std::min(str.size(), BinaryLog::MaxStringLength));
+    std::memcpy(out, &length, sizeof(length));
+    std::memcpy(out + sizeof(length), str.data(), length);
+    out += sizeof(length) + length;
+  } else if constexpr (type == BinaryArgType::Bool || type == BinaryArgType::Char) {
+    *out++ = static_cast<unsigned char>(value);
+  } else {
+    // Widened so the decoder only has to know the kind of value, not its size.
+    uint64_t bits;
+    if constexpr (type == BinaryArgType::Float) {
+      const double widened = value;
+      std::memcpy(&bits, &widened, sizeof(bits));
+    } else if constexpr (type == BinaryArgType::Pointer) {
+      bits = reinterpret_cast<uintptr_t>(value);
+    } else if constexpr (type == BinaryArgType::Int) {
+      const int64_t widened = value;
+      std::memcpy(&bits, &widened, sizeof(bits));
+    } else {
+      bits = value;
+    }
+    std::memcpy(out, &bits, sizeof(bits));
+    out += sizeof(bits);
+  }
+}
+}  // namespace BinaryLogDetail
+}  // namespace Onyx
+
+#if ONYX_BINARY_LOG
+#define ONYX_BINARY_LOG_WRITE(level, ...)                                      \
+  do {                                                                         \
+    static ::Onyx::BinaryLogSite onyxBinaryLogSite{level, __FILE__, __LINE__}; \
+    ::Onyx::BinaryLog::Write(onyxBinaryLogSite, __VA_ARGS__);                  \
+  } while (false)
+#else
+#define ONYX_BINARY_LOG_WRITE(level, ...) ((void)0)
+#endif
+
+// Same as the text log macros, but only the format string's call site and the raw arguments are
+// recorded. The format string must be a literal.
+#define OnyxTraceBinary(...) ONYX_BINARY_LOG_WRITE(ONYX_LOG_LEVEL_TRACE, __VA_ARGS__)
+#define OnyxDebugBinary(...) ONYX_BINARY_LOG_WRITE(ONYX_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define OnyxInfoBinary(...) ONYX_BINARY_LOG_WRITE(ONYX_LOG_LEVEL_INFO, __VA_ARGS__)
+#define OnyxWarnBinary(...) ONYX_BINARY_LOG_WRITE(ONYX_LOG_LEVEL_WARN, __VA_ARGS__)
+#define OnyxErrorBinary(...) ONYX_BINARY_LOG_WRITE(ONYX_LOG_LEVEL_ERROR, __VA_ARGS__)
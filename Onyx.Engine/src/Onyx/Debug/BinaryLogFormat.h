@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+
+// Layout of the files written by BinaryLog, shared with Onyx.LogDecoder. Values are stored in
+// native byte order, which is little-endian on every supported platform.
+//
+//   Header:  u32 magic, u32 version
+//   Site:    u8 BinaryLogRecord::Site, u32 id, u8 level, u32 line, u8 argument count,
+//            one BinaryArgType per argument, string file, string format
+//   Message: u8 BinaryLogRecord::Message, u16 thread, u16 payload size, payload
+//
+// A payload is the u32 site id, the u64 nanoseconds since the log was opened and then every
+// argument: 8 bytes for Int, UInt, Float and Pointer, 1 byte for Bool and Char, and a string for
+// String. Strings are a u16 length followed by that many bytes.
+namespace Onyx {
+constexpr uint32_t BinaryLogMagic = 0x4c42584f;  // "OXBL"
+constexpr uint32_t BinaryLogVersion = 1;
+
+enum class BinaryLogRecord : uint8_t { Site = 1, Message = 2 };
+
+enum class BinaryArgType : uint8_t { Int, UInt, Float, Bool, Char, String, Pointer };
+}  // namespace Onyx
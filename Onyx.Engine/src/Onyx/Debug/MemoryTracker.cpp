@@ -0,0 +1,122 @@
+#include "pch.h"
+
+#include "MemoryTracker.h"
+
+#if ONYX_MEMORY_TRACKING
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+
+namespace Onyx {
+// Placed in front of every allocation. Its size keeps the memory handed out as aligned as
+// malloc's.
+struct alignas(std::max_align_t) AllocationHeader {
+  uint64_t Size;
+  MemoryTag Tag;
+};
+
+struct MemoryTagCounters {
+  std::atomic<uint64_t> LiveBytes{0};
+  std::atomic<uint64_t> PeakBytes{0};
+  std::atomic<uint64_t> LiveAllocations{0};
+  std::atomic<uint64_t> FrameAllocations{0};
+  std::atomic<uint64_t> FrameBytes{0};
+  std::atomic<uint64_t> LastFrameAllocations{0};
+  std::atomic<uint64_t> LastFrameBytes{0};
+};
+
+// Plain atomics only, so the counters are usable by allocations made during static
+// initialization.
+static std::array<MemoryTagCounters, static_cast<size_t>(MemoryTag::Count)> s_Counters;
+static thread_local MemoryTag s_ThreadTag = MemoryTag::Untagged;
+
+void* MemoryTracker::Allocate(size_t size, MemoryTag tag) {
+  auto* header = static_cast<AllocationHeader*>(std::malloc(sizeof(AllocationHeader) + size));
+  if (!header) {
+    return nullptr;
+  }
+  header->Size = size;
+  header->Tag = tag;
+
+  MemoryTagCounters& counters = s_Counters[static_cast<size_t>(tag)];
+  const uint64_t live = counters.LiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+  uint64_t peak = counters.PeakBytes.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !counters.PeakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+  counters.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+  counters.FrameAllocations.fetch_add(1, std::memory_order_relaxed);
+  counters.FrameBytes.fetch_add(size, std::memory_order_relaxed);
+
+  return header + 1;
+}
+
+void MemoryTracker::Free(void* ptr) {
+  if (!ptr) {
+    return;
+  }
+
+  AllocationHeader* header = static_cast<AllocationHeader*>(ptr) - 1;
+  MemoryTagCounters& counters = s_Counters[static_cast<size_t>(header->Tag)];
+  counters.LiveBytes.fetch_sub(header->Size, std::memory_order_relaxed);
+  counters.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+  std::free(header);
+}
+
+MemoryTag MemoryTracker::GetThreadTag() { return s_ThreadTag; }
+
+MemoryTag MemoryTracker::SetThreadTag(MemoryTag tag) {
+  const MemoryTag previous = s_ThreadTag;
+  s_ThreadTag = tag;
+  return previous;
+}
+
+void MemoryTracker::OnFrameEnd() {
+  for (MemoryTagCounters& counters : s_Counters) {
+    counters.LastFrameAllocations.store(
+        counters.FrameAllocations.exchange(0, std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    counters.LastFrameBytes.store(counters.FrameBytes.exchange(0, std::memory_order_relaxed),
+                                  std::memory_order_relaxed);
+  }
+}
+
+MemoryTagStats MemoryTracker::GetStats(MemoryTag tag) {
+  const MemoryTagCounters& counters = s_Counters[static_cast<size_t>(tag)];
+  MemoryTagStats stats;
+  stats.LiveBytes = counters.LiveBytes.load(std::memory_order_relaxed);
+  stats.PeakBytes = counters.PeakBytes.load(std::memory_order_relaxed);
+  stats.LiveAllocations = counters.LiveAllocations.load(std::memory_order_relaxed);
+  stats.FrameAllocations = counters.LastFrameAllocations.load(std::memory_order_relaxed);
+  stats.FrameBytes = counters.LastFrameBytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag) {
+  switch (tag) {
+    case MemoryTag::Untagged:
+      return "Untagged";
+    case MemoryTag::Window:
+      return "Window";
+    case MemoryTag::Events:
+      return "Events";
+    case MemoryTag::Layers:
+      return "Layers";
+    case MemoryTag::Assets:
+      return "Assets";
+    case MemoryTag::Renderer:
+      return "Renderer";
+    case MemoryTag::Jobs:
+      return "Jobs";
+    case MemoryTag::ImGui:
+      return "ImGui";
+    case MemoryTag::Count:
+      break;
+  }
+
+  return "Unknown";
+}
+}  // namespace Onyx
+
+#endif
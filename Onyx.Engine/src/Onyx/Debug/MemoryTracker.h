@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Onyx/Core.h"
+
+// Enabled with premake's --memory-tracking option, never in Dist.
+#if !defined(ONYX_MEMORY_TRACKING) || defined(ONYX_DIST)
+#undef ONYX_MEMORY_TRACKING
+#define ONYX_MEMORY_TRACKING 0
+#endif
+
+#if ONYX_MEMORY_TRACKING
+namespace Onyx {
+// Subsystem an allocation is charged to.
+enum class MemoryTag : uint8_t {
+  Untagged,
+  Window,
+  Events,
+  Layers,
+  Assets,
+  Renderer,
+  Jobs,
+  ImGui,
+  Count
+};
+
+struct MemoryTagStats {
+  uint64_t LiveBytes = 0;
+  uint64_t PeakBytes = 0;
+  uint64_t LiveAllocations = 0;
+  // Over the last completed frame.
+  uint64_t FrameAllocations = 0;
+  uint64_t FrameBytes = 0;
+};
+
+// Counts allocations per tag. Each allocation carries a small header recording its size and tag,
+// so frees are charged to the tag that allocated, whichever thread frees. On Linux every call to
+// the global operator new is counted, charged to the allocating thread's current tag; ImGui's
+// allocations are always charged to MemoryTag::ImGui.
+class ONYX_API MemoryTracker final {
+ public:
+  static void* Allocate(size_t size, MemoryTag tag);
+  static void* Allocate(size_t size) { return Allocate(size, GetThreadTag()); }
+  // Only for memory returned by Allocate.
+  static void Free(void* ptr);
+
+  static MemoryTag GetThreadTag();
+  // Returns the previous tag.
+  static MemoryTag SetThreadTag(MemoryTag tag);
+
+  // Latches the per-frame counters.
+  static void OnFrameEnd();
+  static MemoryTagStats GetStats(MemoryTag tag);
+  static const char* GetTagName(MemoryTag tag);
+};
+
+class MemoryTagScope final {
+ public:
+  MemoryTagScope(MemoryTag tag) : m_Previous(MemoryTracker::SetThreadTag(tag)) {}
+  ~MemoryTagScope() { MemoryTracker::SetThreadTag(m_Previous); }
+
+  MemoryTagScope(const MemoryTagScope&) = delete;
+  MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+ private:
+  MemoryTag m_Previous;
+};
+}  // namespace Onyx
+
+#define ONYX_MEMORY_CONCAT_IMPL(a, b) a##b
+#define ONYX_MEMORY_CONCAT(a, b) ONYX_MEMORY_CONCAT_IMPL(a, b)
+
+#define ONYX_MEMORY_TAG(tag) \
+  ::Onyx::MemoryTagScope ONYX_MEMORY_CONCAT(onyxMemoryTag, __LINE__)(::Onyx::MemoryTag::tag)
+#define ONYX_MEMORY_THREAD_TAG(tag) ::Onyx::MemoryTracker::SetThreadTag(::Onyx::MemoryTag::tag)
+#define ONYX_MEMORY_FRAME_END() ::Onyx::MemoryTracker::OnFrameEnd()
+#else
+#define ONYX_MEMORY_TAG(tag)
+#define ONYX_MEMORY_THREAD_TAG(tag)
+#define ONYX_MEMORY_FRAME_END()
+#endif
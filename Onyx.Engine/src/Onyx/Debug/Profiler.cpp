@@ -0,0 +1,225 @@
+#include "pch.h"
+
+#include "Profiler.h"
+
+#if ONYX_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+
+namespace Onyx {
+struct ProfileEvent {
+  const char* Name;
+  uint64_t Start;
+  uint64_t Duration;
+};
+
+// Single-producer, single-consumer ring. The owning thread advances Head, the flushing thread
+// advances Tail, so neither side ever has to lock.
+struct ProfileThreadBuffer {
+  static constexpr uint64_t Capacity = 1 << 16;
+
+  ProfileEvent Events[Capacity];
+  std::atomic<uint64_t> Head{0};
+  std::atomic<uint64_t> Tail{0};
+  std::atomic<uint64_t> Dropped{0};
+  uint32_t ThreadID = 0;
+  std::string ThreadName;
+};
+
+struct ProfilerData {
+  std::mutex Mutex;  // Guards the session and buffer registration, never taken while recording.
+  std::vector<Scope<ProfileThreadBuffer>> Buffers;
+  std::atomic<bool> Active{false};
+  std::string SessionName;
+  std::ofstream Output;
+  size_t EventsWritten = 0;
+  unsigned int FramesRemaining = 0;
+};
+
+static ProfilerData s_Data;
+static thread_local ProfileThreadBuffer* s_ThreadBuffer = nullptr;
+static const std::chrono::steady_clock::time_point s_Epoch = std::chrono::steady_clock::now();
+
+static ProfileThreadBuffer& GetThreadBuffer() {
+  if (!s_ThreadBuffer) {
+    std::lock_guard<std::mutex> lock(s_Data.Mutex);
+    auto buffer = CreateScope<ProfileThreadBuffer>();
+    buffer->ThreadID = static_cast<uint32_t>(s_Data.Buffers.size());
+    s_ThreadBuffer = buffer.get();
+    s_Data.Buffers.emplace_back(std::move(buffer));
+  }
+
+  return *s_ThreadBuffer;
+}
+
+static void WriteEscaped(std::ofstream& out, const char* str) {
+  for (; *str; ++str) {
+    if (*str == '"' || *str == '\\') {
+      out << '\\' << *str;
+    } else if (static_cast<unsigned char>(*str) < 0x20) {
+      // JSON strings can't hold raw control characters.
+      char escaped[7];
+      std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(*str));
+      out << escaped;
+    } else {
+      out << *str;
+    }
+  }
+}
+
+// Must be called with the mutex held.
+static void DrainBuffers() {
+  std::ofstream& out = s_Data.Output;
+  for (auto& buffer : s_Data.Buffers) {
+    uint64_t tail = buffer->Tail.load(std::memory_order_relaxed);
+    const uint64_t head = buffer->Head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+      const ProfileEvent& evt = buffer->Events[tail & (ProfileThreadBuffer::Capacity - 1)];
+      out << (s_Data.EventsWritten++ ? ",\n" : "\n");
+      out << R"({"cat":"function","ph":"X","pid":0,"tid":)" << buffer->ThreadID;
+      out << R"(,"ts":)" << evt.Start / 1000.0 << R"(,"dur":)" << evt.Duration / 1000.0;
+      out << R"(,"name":")";
+      WriteEscaped(out, evt.Name);
+      out << "\"}";
+    }
+    buffer->Tail.store(head, std::memory_order_release);
+  }
+}
+
+static void DiscardBuffers() {
+  for (auto& buffer : s_Data.Buffers) {
+    buffer->Tail.store(buffer->Head.load(std::memory_order_acquire), std::memory_order_release);
+    buffer->Dropped.store(0, std::memory_order_relaxed);
+  }
+}
+
+void Profiler::BeginSession(const std::string& name, const std::string& filepath,
+                            unsigned int frames) {
+  std::lock_guard<std::mutex> lock(s_Data.Mutex);
+  if (s_Data.Active.load(std::memory_order_relaxed)) {
+    OnyxWarn("Profiler session '{}' already running, ignoring '{}'", s_Data.SessionName, name);
+    return;
+  }
+
+  s_Data.Output.open(filepath);
+  if (!s_Data.Output.is_open()) {
+    OnyxError("Failed to open profiler output '{}'", filepath);
+    return;
+  }
+
+  OnyxInfo("Profiler session '{}' started, writing to '{}'", name, filepath);
+  s_Data.SessionName = name;
+  s_Data.EventsWritten = 0;
+  s_Data.FramesRemaining = frames;
+  s_Data.Output << std::fixed << std::setprecision(3);
+  s_Data.Output << R"({"otherData":{"session":")";
+  WriteEscaped(s_Data.Output, name.c_str());
+  s_Data.Output << R"("},"traceEvents":[)";
+
+  DiscardBuffers();
+  s_Data.Active.store(true, std::memory_order_release);
+}
+
+void Profiler::EndSession() {
+  std::lock_guard<std::mutex> lock(s_Data.Mutex);
+  if (!s_Data.Active.load(std::memory_order_relaxed)) {
+    return;
+  }
+  s_Data.Active.store(false, std::memory_order_release);
+
+  DrainBuffers();
+  uint64_t dropped = 0;
+  for (auto& buffer : s_Data.Buffers) {
+    dropped += buffer->Dropped.exchange(0, std::memory_order_relaxed);
+    if (!buffer->ThreadName.empty()) {
+      s_Data.Output << ",\n" << R"({"ph":"M","pid":0,"name":"thread_name","tid":)";
+      s_Data.Output << buffer->ThreadID << R"(,"args":{"name":")";
+      WriteEscaped(s_Data.Output, buffer->ThreadName.c_str());
+      s_Data.Output << "\"}}";
+    }
+  }
+  s_Data.Output << "\n]}\n";
+  s_Data.Output.close();
+
+  OnyxInfo("Profiler session '{}' ended, {} events written", s_Data.SessionName,
+           s_Data.EventsWritten);
+  if (dropped) {
+    OnyxWarn("Profiler dropped {} events, flush more often or shorten the session", dropped);
+  }
+}
+
+bool Profiler::IsActive() { return s_Data.Active.load(std::memory_order_relaxed); }
+
+void Profiler::OnFrameEnd() {
+  if (!IsActive()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(s_Data.Mutex);
+    // Drain rings that are getting full so long sessions don't drop events.
+    for (auto& buffer : s_Data.Buffers) {
+      const uint64_t used = buffer->Head.load(std::memory_order_acquire) -
+                            buffer->Tail.load(std::memory_order_relaxed);
+      if (used > ProfileThreadBuffer::Capacity / 2) {
+        DrainBuffers();
+        break;
+      }
+    }
+
+    if (s_Data.FramesRemaining == 0 || --s_Data.FramesRemaining > 0) {
+      return;
+    }
+  }
+
+  EndSession();
+}
+
+void Profiler::SetThreadName(const char* name) {
+  ProfileThreadBuffer& buffer = GetThreadBuffer();
+  std::lock_guard<std::mutex> lock(s_Data.Mutex);
+  buffer.ThreadName = name;
+}
+
+void Profiler::Record(const char* name, uint64_t startNs, uint64_t durationNs) {
+  Record(&GetThreadBuffer(), name, startNs, durationNs);
+}
+
+ProfileThreadBuffer* Profiler::CreateTrack(const char* name) {
+  std::lock_guard<std::mutex> lock(s_Data.Mutex);
+  auto buffer = CreateScope<ProfileThreadBuffer>();
+  buffer->ThreadID = static_cast<uint32_t>(s_Data.Buffers.size());
+  buffer->ThreadName = name;
+  ProfileThreadBuffer* track = buffer.get();
+  s_Data.Buffers.emplace_back(std::move(buffer));
+  return track;
+}
+
+void Profiler::Record(ProfileThreadBuffer* track, const char* name, uint64_t startNs,
+                      uint64_t durationNs) {
+  ProfileThreadBuffer& buffer = *track;
+  const uint64_t head = buffer.Head.load(std::memory_order_relaxed);
+  if (head - buffer.Tail.load(std::memory_order_acquire) >= ProfileThreadBuffer::Capacity) {
+    buffer.Dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  buffer.Events[head & (ProfileThreadBuffer::Capacity - 1)] = {name, startNs, durationNs};
+  buffer.Head.store(head + 1, std::memory_order_release);
+}
+
+uint64_t Profiler::Now() {
+  // Offset by one so a valid timestamp is never zero, ProfileScope uses zero as "not recording".
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              s_Epoch)
+             .count() +
+         1;
+}
+}  // namespace Onyx
+
+#endif /* ONYX_PROFILE */
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Onyx/Core.h"
+
+#ifndef ONYX_PROFILE
+#ifdef ONYX_DIST
+#define ONYX_PROFILE 0
+#else
+#define ONYX_PROFILE 1
+#endif
+#endif
+
+#if ONYX_PROFILE
+namespace Onyx {
+struct ProfileThreadBuffer;
+
+// Collects timed scopes into per-thread buffers and writes them out as a Chrome trace
+// (chrome://tracing, ui.perfetto.dev). Recording is lock-free: each thread owns a single-producer
+// ring that is only drained when the session is flushed.
+class ONYX_API Profiler final {
+ public:
+  // Starts capturing events, to be written to filepath. When frames is non-zero, the session ends
+  // on its own after that many calls to OnFrameEnd().
+  static void BeginSession(const std::string& name, const std::string& filepath,
+                           unsigned int frames = 0);
+  static void EndSession();
+  static bool IsActive();
+
+  static void OnFrameEnd();
+  static void SetThreadName(const char* name);
+
+  // Name must have static storage duration, only the pointer is kept.
+  static void Record(const char* name, uint64_t startNs, uint64_t durationNs);
+  // A timeline of its own for events that don't belong to the recording thread, such as GPU work.
+  // Tracks live as long as the program; only one thread may record to each.
+  static ProfileThreadBuffer* CreateTrack(const char* name);
+  static void Record(ProfileThreadBuffer* track, const char* name, uint64_t startNs,
+                     uint64_t durationNs);
+  static uint64_t Now();
+};
+
+class ProfileScope final {
+ public:
+  ProfileScope(const char* name)
+      : m_Name(name), m_Start(Profiler::IsActive() ? Profiler::Now() : 0) {}
+  ~ProfileScope() {
+    if (m_Start) {
+      Profiler::Record(m_Name, m_Start, Profiler::Now() - m_Start);
+    }
+  }
+
+  ProfileScope(const ProfileScope&) = delete;
+  ProfileScope& operator=(const ProfileScope&) = delete;
+
+ private:
+  const char* m_Name;
+  uint64_t m_Start;
+};
+}  // namespace Onyx
+
+#if defined(_MSC_VER)
+#define ONYX_FUNC_SIG __FUNCSIG__
+#else
+#define ONYX_FUNC_SIG __PRETTY_FUNCTION__
+#endif
+
+#define ONYX_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ONYX_PROFILE_CONCAT(a, b) ONYX_PROFILE_CONCAT_IMPL(a, b)
+
+#define ONYX_PROFILE_BEGIN_SESSION(name, filepath, frames) \
+  ::Onyx::Profiler::BeginSession(name, filepath, frames)
+#define ONYX_PROFILE_END_SESSION() ::Onyx::Profiler::EndSession()
+#define ONYX_PROFILE_FRAME_END() ::Onyx::Profiler::OnFrameEnd()
+#define ONYX_PROFILE_THREAD(name) ::Onyx::Profiler::SetThreadName(name)
+#define ONYX_PROFILE_SCOPE(name) \
+  ::Onyx::ProfileScope ONYX_PROFILE_CONCAT(onyxProfileScope, __LINE__)(name)
+#define ONYX_PROFILE_FUNCTION() ONYX_PROFILE_SCOPE(ONYX_FUNC_SIG)
+#else
+#define ONYX_PROFILE_BEGIN_SESSION(name, filepath, frames)
+#define ONYX_PROFILE_END_SESSION()
+#define ONYX_PROFILE_FRAME_END()
+#define ONYX_PROFILE_THREAD(name)
+#define ONYX_PROFILE_SCOPE(name)
+#define ONYX_PROFILE_FUNCTION()
+#endif
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 extern Onyx::Application* Onyx::CreateApplication();
 
-#ifdef ONYX_PLATFORM_WINDOWS
+#if defined(ONYX_PLATFORM_WINDOWS) || defined(ONYX_PLATFORM_LINUX)
 int main(int argc, char** argv) {
   Onyx::Log::Init();
   OnyxInfo("Initializing application...");
@@ -13,5 +13,6 @@ int main(int argc, char** argv) {
   Onyx::Application* app = Onyx::CreateApplication();
   app->Run();
   delete app;
+  Onyx::Log::Shutdown();
 }
 #endif
\ No newline at end of file
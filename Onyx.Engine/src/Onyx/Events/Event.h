@@ -20,8 +20,11 @@ enum class EventType {
   MouseScrolled
 };
 
+constexpr size_t EventTypeCount = static_cast<size_t>(EventType::MouseScrolled) + 1;
+
 #define EVENT_CLASS_TYPE(type)                                        \
-  static EventType GetStaticType() { return EventType::##type; }      \
+  static constexpr EventType StaticType = EventType::type;            \
+  static EventType GetStaticType() { return StaticType; }             \
   EventType GetEventType() const override { return GetStaticType(); } \
   const char* GetName() const override { return #type; }
 
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Events/Event.h"
+
+namespace Onyx {
+template <typename T>
+constexpr size_t EventTypeIndex() {
+  static_assert(std::is_base_of<Event, T>::value, "T must be an Event");
+  return static_cast<size_t>(T::StaticType);
+}
+
+// Type-erased pointer to a member function handling one concrete event type. Calling it is a
+// plain function pointer call, the event is passed through without being copied.
+struct EventHandler {
+  using Thunk = bool (*)(void* instance, const Event& e);
+
+  void* Instance = nullptr;
+  Thunk Fn = nullptr;
+
+  bool operator()(const Event& e) const { return Fn(Instance, e); }
+};
+
+template <typename>
+struct EventHandlerTraits;
+
+template <typename C, typename T>
+struct EventHandlerTraits<bool (C::*)(const T&)> {
+  using Class = C;
+  using EventT = T;
+};
+
+// Builds an EventHandler for a member function of the form `bool C::Handler(const T&)`.
+template <auto Method>
+EventHandler MakeEventHandler(typename EventHandlerTraits<decltype(Method)>::Class* instance) {
+  using Traits = EventHandlerTraits<decltype(Method)>;
+  EventHandler handler;
+  handler.Instance = instance;
+  handler.Fn = [](void* instance, const Event& e) {
+    return (static_cast<typename Traits::Class*>(instance)->*Method)(
+        static_cast<const typename Traits::EventT&>(e));
+  };
+
+  return handler;
+}
+
+struct EventSubscription {
+  size_t Type;
+  EventHandler Handler;
+};
+
+// Keeps one handler list per event type, so dispatching an event only visits the handlers that
+// asked for it, in subscription order, until one of them reports the event as handled.
+class EventDispatcher final {
+ public:
+  template <auto Method>
+  void Subscribe(typename EventHandlerTraits<decltype(Method)>::Class* instance) {
+    using EventT = typename EventHandlerTraits<decltype(Method)>::EventT;
+    Subscribe({EventTypeIndex<EventT>(), MakeEventHandler<Method>(instance)});
+  }
+
+  void Subscribe(const EventSubscription& subscription) {
+    m_Handlers[subscription.Type].push_back(subscription.Handler);
+  }
+
+  void Clear() {
+    for (auto& handlers : m_Handlers) {
+      handlers.clear();
+    }
+  }
+
+  // Type known at compile time, the handler list is selected without a virtual call.
+  template <typename T>
+  bool Dispatch(const T& e) const {
+    return Dispatch(EventTypeIndex<T>(), e);
+  }
+
+  bool Dispatch(const Event& e) const {
+    return Dispatch(static_cast<size_t>(e.GetEventType()), e);
+  }
+
+ private:
+  bool Dispatch(size_t type, const Event& e) const {
+    for (const EventHandler& handler : m_Handlers[type]) {
+      if (handler(e)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  std::array<std::vector<EventHandler>, EventTypeCount> m_Handlers;
+};
+}  // namespace Onyx
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "pch.h"
+
+#include "EventQueue.h"
+
+namespace Onyx {
+void EventQueue::Push(const QueuedEvent& e) {
+  m_PendingStats.Pushed++;
+
+  if (m_Count > 0 && CanCoalesce(e.Type)) {
+    QueuedEvent& last = m_Events[(m_Head + m_Count - 1) % Capacity];
+    if (last.Type == e.Type) {
+      if (e.Type == EventType::MouseScrolled) {
+        last.ScrollOffset += e.ScrollOffset;
+      } else {
+        last = e;
+      }
+      m_PendingStats.Coalesced++;
+      return;
+    }
+  }
+
+  if (m_Count == Capacity) {
+    if (m_PendingStats.Dropped++ == 0) {
+      OnyxWarn("Event queue is full, dropping events until the next dispatch");
+    }
+    return;
+  }
+
+  m_Events[(m_Head + m_Count) % Capacity] = e;
+  m_Count++;
+}
+
+void EventQueue::Clear() {
+  m_Head = 0;
+  m_Count = 0;
+}
+
+bool EventQueue::CanCoalesce(EventType type) const {
+  switch (type) {
+    case EventType::WindowResized:
+    case EventType::MouseMoved:
+    case EventType::MouseScrolled:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void EventQueue::EndDispatch() {
+  m_FrameStats = m_PendingStats;
+  m_TotalStats.Pushed += m_PendingStats.Pushed;
+  m_TotalStats.Coalesced += m_PendingStats.Coalesced;
+  m_TotalStats.Dispatched += m_PendingStats.Dispatched;
+  m_TotalStats.Dropped += m_PendingStats.Dropped;
+  m_PendingStats = EventQueueStats();
+}
+}  // namespace Onyx
\ No newline at end of file
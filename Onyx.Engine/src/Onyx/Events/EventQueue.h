@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Onyx/Core.h"
+#include "Onyx/Events/ApplicationEvent.h"
+#include "Onyx/Events/Event.h"
+#include "Onyx/Events/KeyEvent.h"
+#include "Onyx/Events/MouseEvent.h"
+
+namespace Onyx {
+// Trivially copyable record of a window event, stored in the EventQueue until the next dispatch.
+struct QueuedEvent {
+  EventType Type = EventType::None;
+  union {
+    struct {
+      unsigned int Width;
+      unsigned int Height;
+    } Resize;
+    unsigned int KeyCode;
+    unsigned int Button;
+    struct {
+      double X;
+      double Y;
+    } Position;
+    double ScrollOffset;
+  };
+
+  static QueuedEvent WindowClosed() { return Make(EventType::WindowClosed); }
+  static QueuedEvent WindowResized(unsigned int width, unsigned int height) {
+    QueuedEvent e = Make(EventType::WindowResized);
+    e.Resize = {width, height};
+    return e;
+  }
+  static QueuedEvent Key(EventType type, unsigned int keyCode) {
+    QueuedEvent e = Make(type);
+    e.KeyCode = keyCode;
+    return e;
+  }
+  static QueuedEvent Mouse(EventType type, unsigned int button) {
+    QueuedEvent e = Make(type);
+    e.Button = button;
+    return e;
+  }
+  static QueuedEvent MouseMoved(double x, double y) {
+    QueuedEvent e = Make(EventType::MouseMoved);
+    e.Position = {x, y};
+    return e;
+  }
+  static QueuedEvent MouseScrolled(double offset) {
+    QueuedEvent e = Make(EventType::MouseScrolled);
+    e.ScrollOffset = offset;
+    return e;
+  }
+
+ private:
+  static QueuedEvent Make(EventType type) {
+    QueuedEvent e;
+    e.Type = type;
+    return e;
+  }
+};
+
+struct EventQueueStats {
+  uint32_t Pushed = 0;     // Events received from the platform layer.
+  uint32_t Coalesced = 0;  // Events merged into the previous one instead of being queued.
+  uint32_t Dispatched = 0;
+  uint32_t Dropped = 0;  // Events lost because the queue was full.
+};
+
+// Fixed-size ring of events collected while polling the window, dispatched once per frame.
+// Consecutive mouse movement, scroll and resize events are merged as they arrive, so a
+// high-frequency device costs one dispatch per frame rather than one per report.
+class ONYX_API EventQueue final {
+ public:
+  static constexpr uint32_t Capacity = 1024;
+
+  void Push(const QueuedEvent& e);
+
+  // Calls fn with each queued event as its concrete type, in the order they were received.
+  template <typename Fn>
+  void Dispatch(Fn&& fn);
+  // Calls fn with each queued event as it is stored, leaving the queue as it is.
+  template <typename Fn>
+  void Visit(Fn&& fn) const;
+  // Drops every queued event without dispatching it.
+  void Clear();
+
+  // Counters for the most recent Dispatch(), and accumulated over the queue's lifetime.
+  const EventQueueStats& GetFrameStats() const { return m_FrameStats; }
+  const EventQueueStats& GetTotalStats() const { return m_TotalStats; }
+
+ private:
+  bool CanCoalesce(EventType type) const;
+  void EndDispatch();
+
+  QueuedEvent m_Events[Capacity];
+  uint32_t m_Head = 0;
+  uint32_t m_Count = 0;
+  EventQueueStats m_PendingStats;
+  EventQueueStats m_FrameStats;
+  EventQueueStats m_TotalStats;
+};
+
+template <typename Fn>
+void EventQueue::Dispatch(Fn&& fn) {
+  // Events pushed while dispatching land at the back and are handled in this same pass.
+  while (m_Count > 0) {
+    const QueuedEvent e = m_Events[m_Head];
+    m_Head = (m_Head + 1) % Capacity;
+    m_Count--;
+    m_PendingStats.Dispatched++;
+
+    switch (e.Type) {
+      case EventType::WindowClosed:
+        fn(WindowClosedEvent());
+        break;
+      case EventType::WindowResized:
+        fn(WindowResizedEvent(e.Resize.Width, e.Resize.Height));
+        break;
+      case EventType::KeyPressed:
+        fn(KeyPressedEvent(e.KeyCode));
+        break;
+      case EventType::KeyReleased:
+        fn(KeyReleasedEvent(e.KeyCode));
+        break;
+      case EventType::KeyTyped:
+        fn(KeyTypedEvent(e.KeyCode));
+        break;
+      case EventType::MousePressed:
+        fn(MousePressedEvent(e.Button));
+        break;
+      case EventType::MouseReleased:
+        fn(MouseReleasedEvent(e.Button));
+        break;
+      case EventType::MouseMoved:
+        fn(MouseMovedEvent(e.Position.X, e.Position.Y));
+        break;
+      case EventType::MouseScrolled:
+        fn(MouseScrolledEvent(e.ScrollOffset));
+        break;
+      case EventType::None:
+        break;
+    }
+  }
+
+  EndDispatch();
+}
+
+template <typename Fn>
+void EventQueue::Visit(Fn&& fn) const {
+  for (uint32_t i = 0; i < m_Count; ++i) {
+    fn(m_Events[(m_Head + i) % Capacity]);
+  }
+}
+}  // namespace Onyx
\ No newline at end of file
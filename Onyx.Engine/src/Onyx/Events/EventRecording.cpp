@@ -0,0 +1,208 @@
+#include "pch.h"
+
+#include "EventRecording.h"
+
+#include <cstring>
+
+namespace Onyx {
+EventRecorder::EventRecorder(const std::string& path, double frameStep)
+    : m_File(path, std::ios::binary), m_Path(path) {
+  if (!m_File) {
+    OnyxError("Failed to open input recording '{}'", path);
+    return;
+  }
+
+  EventRecordingHeader header;
+  header.FrameStep = frameStep;
+  m_File.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  OnyxInfo("Recording input to '{}'", path);
+}
+
+EventRecorder::~EventRecorder() { Finish(m_LastFrame); }
+
+void EventRecorder::Record(uint64_t frame, const QueuedEvent& e) {
+  if (!IsOpen()) {
+    return;
+  }
+
+  WriteRecord(frame, e.Type);
+  switch (e.Type) {
+    case EventType::WindowResized:
+      WriteVarint(e.Resize.Width);
+      WriteVarint(e.Resize.Height);
+      break;
+    case EventType::KeyPressed:
+    case EventType::KeyReleased:
+    case EventType::KeyTyped:
+      WriteVarint(e.KeyCode);
+      break;
+    case EventType::MousePressed:
+    case EventType::MouseReleased:
+      WriteVarint(e.Button);
+      break;
+    case EventType::MouseMoved:
+      m_File.write(reinterpret_cast<const char*>(&e.Position.X), sizeof(double));
+      m_File.write(reinterpret_cast<const char*>(&e.Position.Y), sizeof(double));
+      break;
+    case EventType::MouseScrolled:
+      m_File.write(reinterpret_cast<const char*>(&e.ScrollOffset), sizeof(double));
+      break;
+    case EventType::WindowClosed:
+    case EventType::None:
+      break;
+  }
+  m_EventCount++;
+}
+
+void EventRecorder::Finish(uint64_t frame) {
+  if (!IsOpen()) {
+    return;
+  }
+
+  WriteRecord(frame, EventType::None);
+  m_File.close();
+  if (m_File.fail()) {
+    OnyxError("Failed to write input recording '{}'", m_Path);
+  } else {
+    OnyxInfo("Recorded {} events over {} frames to '{}'", m_EventCount, frame + 1, m_Path);
+  }
+}
+
+void EventRecorder::WriteVarint(uint64_t value) {
+  unsigned char bytes[10];
+  size_t size = 0;
+  do {
+    bytes[size] = static_cast<unsigned char>(value & 0x7f);
+    value >>= 7;
+    bytes[size++] |= value ? 0x80 : 0;
+  } while (value);
+  m_File.write(reinterpret_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+}
+
+void EventRecorder::WriteRecord(uint64_t frame, EventType type) {
+  OnyxAssert(frame >= m_LastFrame, "Input recorded out of order!");
+  WriteVarint(frame - m_LastFrame);
+  m_File.put(static_cast<char>(type));
+  m_LastFrame = frame;
+}
+
+EventPlayer::EventPlayer(const std::string& path) : m_Path(path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    OnyxError("Failed to open input recording '{}'", path);
+    return;
+  }
+  m_Data.resize(static_cast<size_t>(file.tellg()));
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(m_Data.data()), static_cast<std::streamsize>(m_Data.size()));
+
+  EventRecordingHeader header;
+  if (!file || m_Data.size() < sizeof(header)) {
+    OnyxError("Input recording '{}' is truncated", path);
+    return;
+  }
+  std::memcpy(&header, m_Data.data(), sizeof(header));
+  if (header.Magic != EventRecordingHeader::ExpectedMagic ||
+      header.Version != EventRecordingHeader::CurrentVersion || header.FrameStep <= 0.0) {
+    OnyxError("'{}' is not an input recording this version can play", path);
+    return;
+  }
+
+  m_Offset = sizeof(header);
+  m_FrameStep = header.FrameStep;
+  m_Open = true;
+  ReadNextFrame();
+  OnyxInfo("Replaying input from '{}'", path);
+}
+
+bool EventPlayer::Play(uint64_t frame, EventQueue& queue) {
+  while (!m_Ended && m_NextFrame == frame) {
+    if (m_Offset >= m_Data.size()) {
+      m_Ended = true;
+      break;
+    }
+
+    const auto type = static_cast<EventType>(m_Data[m_Offset++]);
+    uint64_t a = 0;
+    uint64_t b = 0;
+    double x = 0.0;
+    double y = 0.0;
+    bool valid = true;
+    switch (type) {
+      case EventType::None:
+        m_Ended = true;
+        OnyxInfo("Input replay of '{}' finished after {} frames", m_Path, frame + 1);
+        return false;
+      case EventType::WindowClosed:
+        queue.Push(QueuedEvent::WindowClosed());
+        break;
+      case EventType::WindowResized:
+        valid = ReadVarint(a) && ReadVarint(b);
+        queue.Push(QueuedEvent::WindowResized(static_cast<unsigned int>(a),
+                                              static_cast<unsigned int>(b)));
+        break;
+      case EventType::KeyPressed:
+      case EventType::KeyReleased:
+      case EventType::KeyTyped:
+        valid = ReadVarint(a);
+        queue.Push(QueuedEvent::Key(type, static_cast<unsigned int>(a)));
+        break;
+      case EventType::MousePressed:
+      case EventType::MouseReleased:
+        valid = ReadVarint(a);
+        queue.Push(QueuedEvent::Mouse(type, static_cast<unsigned int>(a)));
+        break;
+      case EventType::MouseMoved:
+        valid = ReadDouble(x) && ReadDouble(y);
+        queue.Push(QueuedEvent::MouseMoved(x, y));
+        break;
+      case EventType::MouseScrolled:
+        valid = ReadDouble(x);
+        queue.Push(QueuedEvent::MouseScrolled(x));
+        break;
+      default:
+        valid = false;
+        break;
+    }
+
+    if (!valid) {
+      OnyxError("Input recording '{}' is corrupt, stopping replay at frame {}", m_Path, frame);
+      m_Ended = true;
+      break;
+    }
+    ReadNextFrame();
+  }
+
+  return !m_Ended;
+}
+
+bool EventPlayer::ReadVarint(uint64_t& value) {
+  value = 0;
+  for (uint32_t shift = 0; shift < 64 && m_Offset < m_Data.size(); shift += 7) {
+    const unsigned char byte = m_Data[m_Offset++];
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool EventPlayer::ReadDouble(double& value) {
+  if (m_Data.size() - m_Offset < sizeof(value)) {
+    return false;
+  }
+  std::memcpy(&value, m_Data.data() + m_Offset, sizeof(value));
+  m_Offset += sizeof(value);
+  return true;
+}
+
+void EventPlayer::ReadNextFrame() {
+  uint64_t delta = 0;
+  if (!ReadVarint(delta)) {
+    m_Ended = true;
+    return;
+  }
+  m_NextFrame += delta;
+}
+}  // namespace Onyx
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Events/EventQueue.h"
+
+namespace Onyx {
+// Input recordings start with this header, followed by one record per event: the number of frames
+// since the previous record as a varint, the event type as a byte, then its payload. Codes and
+// sizes are varints, positions and scroll offsets are stored exactly as doubles. A record of type
+// None marks the frame the recording ended on.
+struct EventRecordingHeader {
+  static constexpr uint32_t ExpectedMagic = 0x5249584f;  // "OXIR"
+  static constexpr uint32_t CurrentVersion = 1;
+
+  uint32_t Magic = ExpectedMagic;
+  uint32_t Version = CurrentVersion;
+  // Timestep every frame of the session ran with, so a replay advances exactly the same way.
+  double FrameStep = 0.0;
+};
+
+// Writes the events of a session to a file, frame by frame.
+class ONYX_API EventRecorder final {
+ public:
+  EventRecorder(const std::string& path, double frameStep);
+  ~EventRecorder();
+
+  EventRecorder(const EventRecorder&) = delete;
+  EventRecorder& operator=(const EventRecorder&) = delete;
+
+  bool IsOpen() const { return m_File.is_open(); }
+
+  // Frames must not go backwards.
+  void Record(uint64_t frame, const QueuedEvent& e);
+  // Marks where the session ended; also done on destruction with the last frame recorded.
+  void Finish(uint64_t frame);
+
+ private:
+  void WriteVarint(uint64_t value);
+  void WriteRecord(uint64_t frame, EventType type);
+
+  std::ofstream m_File;
+  std::string m_Path;
+  uint64_t m_LastFrame = 0;
+  uint64_t m_EventCount = 0;
+};
+
+// Plays a recording back into an event queue in place of the window's own events. The whole file
+// is read up front, so playback never touches the disk.
+class ONYX_API EventPlayer final {
+ public:
+  explicit EventPlayer(const std::string& path);
+
+  bool IsOpen() const { return m_Open; }
+  double GetFrameStep() const { return m_FrameStep; }
+
+  // Pushes every event recorded for the frame. Returns false once the recording has ended.
+  bool Play(uint64_t frame, EventQueue& queue);
+
+ private:
+  bool ReadVarint(uint64_t& value);
+  bool ReadDouble(double& value);
+  // Reads the frame of the next record, if any.
+  void ReadNextFrame();
+
+  std::vector<unsigned char> m_Data;
+  size_t m_Offset = 0;
+  bool m_Open = false;
+  bool m_Ended = false;
+  double m_FrameStep = 0.0;
+  uint64_t m_NextFrame = 0;
+  std::string m_Path;
+};
+}  // namespace Onyx
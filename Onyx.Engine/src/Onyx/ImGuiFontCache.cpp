@@ -0,0 +1,332 @@
+#include "pch.h"
+
+#include "ImGuiFontCache.h"
+
+#include <imgui.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "Onyx/MappedFile.h"
+
+namespace Onyx {
+#ifdef IM_DRAWLIST_TEX_LINES_WIDTH_MAX
+static constexpr uint32_t s_UvLineCount = IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1;
+#else
+static constexpr uint32_t s_UvLineCount = 0;
+#endif
+
+// A cache file is this header, the baked line UVs, the atlas' custom rects followed by the index
+// of the font each belongs to, every font's metrics and glyphs, and finally the 8 bit coverage the
+// atlas was built with. Structs are stored as laid out in memory, which is safe because the key
+// covers the ImGui version and the size of each of them.
+struct FontCacheHeader {
+  static constexpr uint32_t ExpectedMagic = 0x4146584f;  // "OXFA"
+
+  uint32_t Magic = ExpectedMagic;
+  uint32_t TexWidth = 0;
+  uint32_t TexHeight = 0;
+  ImVec2 TexUvWhitePixel;
+  uint32_t UvLineCount = s_UvLineCount;
+  uint32_t CustomRectCount = 0;
+  int32_t MouseCursorRect = -1;
+  uint32_t FontCount = 0;
+};
+
+struct FontCacheFont {
+  float FontSize = 0.0f;
+  float Ascent = 0.0f;
+  float Descent = 0.0f;
+  uint32_t FallbackChar = 0;
+  uint32_t EllipsisChar = 0;
+  int32_t MetricsTotalSurface = 0;
+  uint32_t GlyphCount = 0;
+};
+
+// Which custom rect holds the mouse cursors was renamed in 1.79.
+static int GetMouseCursorRect(const ImFontAtlas& atlas) {
+#if IMGUI_VERSION_NUM >= 17900
+  return atlas.PackIdMouseCursors;
+#else
+  return atlas.CustomRectIds[0];
+#endif
+}
+
+static void SetMouseCursorRect(ImFontAtlas& atlas, int rect) {
+#if IMGUI_VERSION_NUM >= 17900
+  atlas.PackIdMouseCursors = rect;
+#else
+  atlas.CustomRectIds[0] = rect;
+#endif
+}
+
+static int32_t FindFont(const ImFontAtlas& atlas, const ImFont* font) {
+  for (int i = 0; i < atlas.Fonts.Size; ++i) {
+    if (atlas.Fonts[i] == font) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// FNV-1a, folding in eight bytes at a time since font files can be tens of megabytes.
+static uint64_t Hash(const void* data, size_t size, uint64_t hash) {
+  constexpr uint64_t Prime = 1099511628211ull;
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), bytes += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    hash = (hash ^ word) * Prime;
+  }
+  for (; size > 0; --size, ++bytes) {
+    hash = (hash ^ *bytes) * Prime;
+  }
+  return hash;
+}
+
+template <typename T>
+static uint64_t HashValue(const T& value, uint64_t hash) {
+  return Hash(&value, sizeof(value), hash);
+}
+
+static std::string GetCachePath(const ImFontAtlas& atlas, const std::string& directory) {
+  uint64_t hash = HashValue(IMGUI_VERSION_NUM, 14695981039346656037ull);
+  hash = HashValue(sizeof(ImFontGlyph), hash);
+  hash = HashValue(sizeof(ImFontAtlasCustomRect), hash);
+  hash = HashValue(sizeof(ImWchar), hash);
+  hash = HashValue(atlas.Flags, hash);
+  hash = HashValue(atlas.TexDesiredWidth, hash);
+  hash = HashValue(atlas.TexGlyphPadding, hash);
+
+  // Rects added by the application take part in packing.
+  for (const ImFontAtlasCustomRect& rect : atlas.CustomRects) {
+    hash = HashValue(rect.Width, hash);
+    hash = HashValue(rect.Height, hash);
+    hash = HashValue(rect.GlyphAdvanceX, hash);
+    hash = HashValue(rect.GlyphOffset.x, hash);
+    hash = HashValue(rect.GlyphOffset.y, hash);
+    hash = HashValue(FindFont(atlas, rect.Font), hash);
+  }
+
+  for (const ImFontConfig& config : atlas.ConfigData) {
+    hash = Hash(config.FontData, static_cast<size_t>(config.FontDataSize), hash);
+    hash = HashValue(config.FontNo, hash);
+    hash = HashValue(config.SizePixels, hash);
+    hash = HashValue(config.OversampleH, hash);
+    hash = HashValue(config.OversampleV, hash);
+    hash = HashValue(config.PixelSnapH, hash);
+    hash = HashValue(config.GlyphExtraSpacing.x, hash);
+    hash = HashValue(config.GlyphExtraSpacing.y, hash);
+    hash = HashValue(config.GlyphOffset.x, hash);
+    hash = HashValue(config.GlyphOffset.y, hash);
+    hash = HashValue(config.GlyphMinAdvanceX, hash);
+    hash = HashValue(config.GlyphMaxAdvanceX, hash);
+    hash = HashValue(config.MergeMode, hash);
+    hash = HashValue(config.RasterizerFlags, hash);
+    hash = HashValue(config.RasterizerMultiply, hash);
+    hash = HashValue(config.EllipsisChar, hash);
+    hash = HashValue(FindFont(atlas, config.DstFont), hash);
+    for (const ImWchar* range = config.GlyphRanges; range && *range; ++range) {
+      hash = HashValue(*range, hash);
+    }
+  }
+
+  char key[17];
+  std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+  return directory + "/imgui-fonts-" + key + ".bin";
+}
+
+// Bounds-checked reads from a cache file.
+class FontCacheReader final {
+ public:
+  FontCacheReader(const unsigned char* data, size_t size) : m_Data(data), m_Size(size) {}
+
+  // Returns nullptr if fewer than size bytes remain.
+  const unsigned char* Take(size_t size) {
+    if (m_Size - m_Offset < size) {
+      return nullptr;
+    }
+    const unsigned char* data = m_Data + m_Offset;
+    m_Offset += size;
+    return data;
+  }
+
+  size_t GetRemaining() const { return m_Size - m_Offset; }
+
+  template <typename T>
+  bool Read(T* values, size_t count = 1) {
+    const unsigned char* data = Take(sizeof(T) * count);
+    if (data && count > 0) {
+      std::memcpy(values, data, sizeof(T) * count);
+    }
+    return data != nullptr;
+  }
+
+ private:
+  const unsigned char* m_Data;
+  size_t m_Size;
+  size_t m_Offset = 0;
+};
+
+bool ImGuiFontCache::Load(ImFontAtlas& atlas, const std::string& directory) {
+  if (directory.empty() || atlas.Fonts.empty()) {
+    return false;
+  }
+
+  const std::string path = GetCachePath(atlas, directory);
+  MappedFile file(path);
+  if (!file.IsOpen()) {
+    return false;
+  }
+
+  // Everything is read up front, so a damaged file leaves the atlas as it was.
+  FontCacheReader reader(file.GetData(), file.GetSize());
+  FontCacheHeader header;
+  if (!reader.Read(&header) || header.Magic != FontCacheHeader::ExpectedMagic ||
+      header.UvLineCount != s_UvLineCount ||
+      header.FontCount != static_cast<uint32_t>(atlas.Fonts.Size) || header.TexWidth == 0 ||
+      header.TexHeight == 0) {
+    OnyxWarn("Ignoring invalid ImGui font cache '{}'", path);
+    return false;
+  }
+
+  // Checked before sizing anything from it, so a corrupt count can't ask for gigabytes.
+  constexpr size_t RectBytes = sizeof(ImFontAtlasCustomRect) + sizeof(int32_t);
+  if (header.CustomRectCount > reader.GetRemaining() / RectBytes) {
+    OnyxWarn("Ignoring truncated ImGui font cache '{}'", path);
+    return false;
+  }
+
+  ImVec4 uvLines[s_UvLineCount > 0 ? s_UvLineCount : 1];
+  ImVector<ImFontAtlasCustomRect> rects;
+  rects.resize(static_cast<int>(header.CustomRectCount));
+  ImVector<int32_t> rectFonts;
+  rectFonts.resize(static_cast<int>(header.CustomRectCount));
+  bool valid = reader.Read(uvLines, s_UvLineCount) && reader.Read(rects.Data, rects.Size) &&
+               reader.Read(rectFonts.Data, rectFonts.Size);
+
+  ImVector<FontCacheFont> fonts;
+  ImVector<const unsigned char*> glyphs;
+  fonts.resize(static_cast<int>(header.FontCount));
+  glyphs.resize(static_cast<int>(header.FontCount));
+  for (int i = 0; valid && i < fonts.Size; ++i) {
+    valid = reader.Read(&fonts[i]) &&
+            (glyphs[i] = reader.Take(fonts[i].GlyphCount * sizeof(ImFontGlyph))) != nullptr;
+  }
+
+  const size_t pixelCount = static_cast<size_t>(header.TexWidth) * header.TexHeight;
+  const unsigned char* pixels = valid ? reader.Take(pixelCount) : nullptr;
+  if (!pixels) {
+    OnyxWarn("Ignoring truncated ImGui font cache '{}'", path);
+    return false;
+  }
+
+  atlas.TexWidth = static_cast<int>(header.TexWidth);
+  atlas.TexHeight = static_cast<int>(header.TexHeight);
+  atlas.TexUvScale = ImVec2(1.0f / atlas.TexWidth, 1.0f / atlas.TexHeight);
+  atlas.TexUvWhitePixel = header.TexUvWhitePixel;
+#ifdef IM_DRAWLIST_TEX_LINES_WIDTH_MAX
+  std::memcpy(atlas.TexUvLines, uvLines, sizeof(atlas.TexUvLines));
+#endif
+  for (int i = 0; i < rects.Size; ++i) {
+    rects[i].Font = rectFonts[i] >= 0 && rectFonts[i] < atlas.Fonts.Size ? atlas.Fonts[rectFonts[i]]
+                                                                        : nullptr;
+  }
+  atlas.CustomRects.swap(rects);
+  SetMouseCursorRect(atlas, header.MouseCursorRect);
+  atlas.TexPixelsAlpha8 = static_cast<unsigned char*>(IM_ALLOC(pixelCount));
+  std::memcpy(atlas.TexPixelsAlpha8, pixels, pixelCount);
+
+  // What building sets up for each font before rasterizing.
+  for (ImFontConfig& config : atlas.ConfigData) {
+    ImFont* font = config.DstFont;
+    if (!config.MergeMode) {
+      font->ConfigData = &config;
+      font->ConfigDataCount = 0;
+      font->ContainerAtlas = &atlas;
+    }
+    font->ConfigDataCount++;
+  }
+
+  for (int i = 0; i < atlas.Fonts.Size; ++i) {
+    ImFont* font = atlas.Fonts[i];
+    const FontCacheFont& cached = fonts[i];
+    font->FontSize = cached.FontSize;
+    font->Ascent = cached.Ascent;
+    font->Descent = cached.Descent;
+    font->FallbackChar = static_cast<ImWchar>(cached.FallbackChar);
+    font->EllipsisChar = static_cast<ImWchar>(cached.EllipsisChar);
+    font->MetricsTotalSurface = cached.MetricsTotalSurface;
+    font->Glyphs.resize(static_cast<int>(cached.GlyphCount));
+    if (cached.GlyphCount > 0) {
+      std::memcpy(font->Glyphs.Data, glyphs[i], cached.GlyphCount * sizeof(ImFontGlyph));
+    }
+    font->BuildLookupTable();
+  }
+  return true;
+}
+
+void ImGuiFontCache::Save(const ImFontAtlas& atlas, const std::string& directory) {
+  if (directory.empty() || !atlas.TexPixelsAlpha8) {
+    return;
+  }
+
+  FontCacheHeader header;
+  header.TexWidth = static_cast<uint32_t>(atlas.TexWidth);
+  header.TexHeight = static_cast<uint32_t>(atlas.TexHeight);
+  header.TexUvWhitePixel = atlas.TexUvWhitePixel;
+  header.CustomRectCount = static_cast<uint32_t>(atlas.CustomRects.Size);
+  header.MouseCursorRect = GetMouseCursorRect(atlas);
+  header.FontCount = static_cast<uint32_t>(atlas.Fonts.Size);
+
+  // Font pointers won't survive the trip, so rects refer to their font by index instead.
+  ImVector<ImFontAtlasCustomRect> rects = atlas.CustomRects;
+  ImVector<int32_t> rectFonts;
+  for (ImFontAtlasCustomRect& rect : rects) {
+    rectFonts.push_back(FindFont(atlas, rect.Font));
+    rect.Font = nullptr;
+  }
+
+  // Written next to the final path and moved into place, so another instance starting up at the
+  // same time never maps a partial file.
+  const std::string path = GetCachePath(atlas, directory);
+  const std::string temporaryPath = path + ".tmp";
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  {
+    std::ofstream file(temporaryPath, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+#ifdef IM_DRAWLIST_TEX_LINES_WIDTH_MAX
+    file.write(reinterpret_cast<const char*>(atlas.TexUvLines), sizeof(atlas.TexUvLines));
+#endif
+    file.write(reinterpret_cast<const char*>(rects.Data), rects.size_in_bytes());
+    file.write(reinterpret_cast<const char*>(rectFonts.Data), rectFonts.size_in_bytes());
+    for (const ImFont* font : atlas.Fonts) {
+      FontCacheFont cached;
+      cached.FontSize = font->FontSize;
+      cached.Ascent = font->Ascent;
+      cached.Descent = font->Descent;
+      cached.FallbackChar = font->FallbackChar;
+      cached.EllipsisChar = font->EllipsisChar;
+      cached.MetricsTotalSurface = font->MetricsTotalSurface;
+      cached.GlyphCount = static_cast<uint32_t>(font->Glyphs.Size);
+      file.write(reinterpret_cast<const char*>(&cached), sizeof(cached));
+      file.write(reinterpret_cast<const char*>(font->Glyphs.Data), font->Glyphs.size_in_bytes());
+    }
+    file.write(reinterpret_cast<const char*>(atlas.TexPixelsAlpha8),
+               static_cast<std::streamsize>(atlas.TexWidth) * atlas.TexHeight);
+    if (!file) {
+      OnyxWarn("Failed to write ImGui font cache '{}'", path);
+      return;
+    }
+  }
+
+  std::filesystem::rename(temporaryPath, path, error);
+  if (error) {
+    OnyxWarn("Failed to write ImGui font cache '{}': {}", path, error.message());
+  }
+}
+}  // namespace Onyx
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+#include "Onyx/Core.h"
+
+struct ImFontAtlas;
+
+namespace Onyx {
+// Stores baked ImGui font atlases between runs, so startup can skip rasterizing every glyph.
+// Entries are keyed by the contents of every font file and by everything in the atlas and font
+// configs that changes the result.
+class ImGuiFontCache final {
+ public:
+  // Restores the atlas as if it had been built. All fonts must have been added to it, and it must
+  // not be built yet. Returns false, leaving the atlas untouched, if there is no usable entry.
+  static bool Load(ImFontAtlas& atlas, const std::string& directory);
+  // Stores a built atlas. Does nothing when the directory is empty.
+  static void Save(const ImFontAtlas& atlas, const std::string& directory);
+};
+}  // namespace Onyx
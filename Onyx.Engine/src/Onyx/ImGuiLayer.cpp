@@ -5,25 +5,88 @@
 #include <GLFW/glfw3.h>
 #include <imgui.h>
 
+#include <chrono>
+#include <cstring>
+
 #include "Onyx/Application.h"
+#include "Onyx/Debug/MemoryTracker.h"
+#include "Onyx/Debug/Profiler.h"
 #include "Onyx/Events/ApplicationEvent.h"
 #include "Onyx/Events/KeyEvent.h"
 #include "Onyx/Events/MouseEvent.h"
+#include "Onyx/ImGuiFontCache.h"
+#include "Onyx/Memory/FrameAllocator.h"
+#include "Onyx/Renderer/GPUProfiler.h"
+#include "Onyx/Renderer/Renderer.h"
+#include "Onyx/Renderer/Renderer2D.h"
+#include "Platform/GLFW/ImGuiGLFWRenderer.h"
 #include "Platform/OpenGL/ImGuiOpenGLRenderer.h"
 
-#ifdef ONYX_PLATFORM_WINDOWS
-#include "Platform/Windows/ImGuiWindowsRenderer.h"
-#endif
-
 namespace Onyx {
-void Onyx::ImGuiLayer::OnAttach() {
+// ImGui reuses its draw lists as soon as the next frame starts, so a frame rendered on another
+// thread needs its own copy. Snapshots are recycled and keep their buffers' capacity.
+struct ImGuiDrawSnapshot {
+  ImDrawData DrawData;
+  ImVector<ImDrawList*> Lists;
+
+  ~ImGuiDrawSnapshot() {
+    for (ImDrawList* list : Lists) {
+      IM_DELETE(list);
+    }
+  }
+
+  template <typename T>
+  static void Copy(ImVector<T>& dst, const ImVector<T>& src) {
+    dst.resize(src.Size);
+    if (src.Size > 0) {
+      std::memcpy(dst.Data, src.Data, src.size_in_bytes());
+    }
+  }
+
+  void Capture(const ImDrawData& src) {
+    while (Lists.Size < src.CmdListsCount) {
+      Lists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+    }
+    for (int i = 0; i < src.CmdListsCount; ++i) {
+      const ImDrawList& srcList = *src.CmdLists[i];
+      ImDrawList& dstList = *Lists[i];
+      Copy(dstList.CmdBuffer, srcList.CmdBuffer);
+      Copy(dstList.IdxBuffer, srcList.IdxBuffer);
+      Copy(dstList.VtxBuffer, srcList.VtxBuffer);
+      dstList.Flags = srcList.Flags;
+    }
+
+    DrawData = src;
+    DrawData.CmdLists = Lists.Data;
+    DrawData.OwnerViewport = nullptr;
+  }
+};
+
+ImGuiLayer::ImGuiLayer(const std::string& fontCacheDirectory)
+    : Layer("ImGui"), m_FontCacheDirectory(fontCacheDirectory) {}
+
+ImGuiLayer::~ImGuiLayer() = default;
+
+void ImGuiLayer::OnAttach() {
   IMGUI_CHECKVERSION();
+#if ONYX_MEMORY_TRACKING
+  ImGui::SetAllocatorFunctions(
+      [](size_t size, void*) { return MemoryTracker::Allocate(size, MemoryTag::ImGui); },
+      [](void* ptr, void*) { MemoryTracker::Free(ptr); });
+#endif
   ImGui::CreateContext();
 
+  Application& app = Application::Get();
+  m_Headless = app.GetWindow()->IsHeadless();
+
   ImGuiIO& io = ImGui::GetIO();
   io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
   io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
-  io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+  // Platform windows need a platform backend, which a headless context does not have, and render
+  // on their own contexts from the main thread, which a render thread rules out.
+  if (!m_Headless && !Renderer::IsThreaded()) {
+    io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
+  }
 
   ImGui::StyleColorsDark();
 
@@ -33,40 +96,242 @@ void Onyx::ImGuiLayer::OnAttach() {
     style.Colors[ImGuiCol_WindowBg].w = 1.0f;
   }
 
-  Application& app = Application::Get();
+  if (!m_Headless) {
+    GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow()->GetNativeHandle());
+    ImGui_ImplGlfw_InitForOpenGL(window, true);
+  }
 
-#ifdef ONYX_PLATFORM_WINDOWS
-  GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow()->GetNativeHandle());
-  ImGui_ImplGlfw_InitForOpenGL(window, true);
-#endif
+  // Baking rasterizes every glyph of every font, which gets slow with large glyph ranges, so the
+  // result is cached. The backend only uploads the atlas once it is built.
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  ImFontAtlas& fonts = *io.Fonts;
+  if (fonts.ConfigData.empty()) {
+    fonts.AddFontDefault();
+  }
+  if (ImGuiFontCache::Load(fonts, m_FontCacheDirectory)) {
+    OnyxInfo("ImGui font atlas loaded from cache in {:.1f}ms",
+             std::chrono::duration<float, std::milli>(Clock::now() - start).count());
+  } else {
+    fonts.Build();
+    OnyxInfo("ImGui font atlas built in {:.1f}ms",
+             std::chrono::duration<float, std::milli>(Clock::now() - start).count());
+    ImGuiFontCache::Save(fonts, m_FontCacheDirectory);
+  }
 
+  // The backend touches ImGui state as well as the context, so wait for it before moving on.
   // TODO: Renderer platform choosing
-  ImGui_ImplOpenGL3_Init("#version 410");
+  Renderer::Submit([]() {
+    ImGui_ImplOpenGL3_Init("#version 410");
+    ImGui_ImplOpenGL3_CreateDeviceObjects();
+  });
+  Renderer::Flush();
+
+  if (Renderer::IsThreaded()) {
+    for (unsigned int i = 0; i <= Renderer::GetFramesInFlight(); ++i) {
+      m_Snapshots.emplace_back(CreateScope<ImGuiDrawSnapshot>());
+    }
+  }
 }
 
 void ImGuiLayer::OnDetach() {
-  ImGui_ImplOpenGL3_Shutdown();
-#ifdef ONYX_PLATFORM_WINDOWS
-  ImGui_ImplGlfw_Shutdown();
-#endif
+  Renderer::Submit([]() { ImGui_ImplOpenGL3_Shutdown(); });
+  Renderer::Flush();
+  m_Snapshots.clear();
+  if (!m_Headless) {
+    ImGui_ImplGlfw_Shutdown();
+  }
   ImGui::DestroyContext();
 }
 
 void ImGuiLayer::OnImGuiRender() {
   static bool show = true;
   ImGui::ShowDemoWindow(&show);
+
+  Application& app = Application::Get();
+  const EventQueueStats& events = app.GetWindow()->GetEventQueue().GetFrameStats();
+  ImGui::Begin("Frame Stats");
+  ImGui::Text("Frame: %.2fms", app.GetFrameTimestep().GetMilliseconds());
+  ImGui::Text("Events: %u dispatched, %u coalesced", events.Dispatched, events.Coalesced);
+  const Renderer2D::Statistics& stats2D = Renderer2D::GetStats();
+  ImGui::Text("2D: %u draws, %u quads", stats2D.DrawCalls, stats2D.QuadCount);
+  const AssetManager::Statistics& assets = app.GetAssetManager().GetStats();
+  ImGui::Text("Assets: %u resident (%.1f MB), %u decoding, %u queued", assets.Resident,
+              assets.ResidentBytes / (1024.0 * 1024.0), assets.Decoding, assets.Queued);
+  ImGui::Text("Uploaded: %u assets (%.1f KB) in %.2fms", assets.UploadedAssets,
+              assets.UploadedBytes / 1024.0, assets.UploadMs);
+  const FrameAllocator::Statistics& frameMemory = FrameAllocator::GetStats();
+  ImGui::Text("Frame memory: %.1f KB used, %.1f KB reserved", frameMemory.UsedBytes / 1024.0,
+              frameMemory.Capacity / 1024.0);
+  const RendererStats& renderer = Renderer::GetStats();
+  if (Renderer::IsThreaded()) {
+    ImGui::Text("Render thread: %.2fms, main thread waited %.2fms", renderer.ExecuteMs,
+                renderer.WaitMs);
+    ImGui::Text("Commands: %u (%zu bytes)", renderer.CommandCount, renderer.CommandBytes);
+  }
+  ImGui::Separator();
+
+  const LayerStack& layers = app.GetLayerStack();
+  ImGui::Columns(4, "LayerTimings");
+  ImGui::Text("Layer");
+  ImGui::NextColumn();
+  ImGui::Text("Fixed (ms)");
+  ImGui::NextColumn();
+  ImGui::Text("Update (ms)");
+  ImGui::NextColumn();
+  ImGui::Text("ImGui (ms)");
+  ImGui::NextColumn();
+  ImGui::Separator();
+  for (size_t i = 0; i < layers.Size(); ++i) {
+    const LayerTiming& timing = layers.GetTiming(i);
+    ImGui::Text("%s", layers.begin()[i]->GetName());
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", timing.FixedUpdateMs);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", timing.UpdateMs);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", timing.ImGuiRenderMs);
+    ImGui::NextColumn();
+  }
+  ImGui::Columns(1);
+  ImGui::End();
+
+  ImGui::Begin("GPU Timings");
+  ImGui::Text("Over the last %u frames, %llu dropped", GPUProfiler::HistorySize,
+              static_cast<unsigned long long>(GPUProfiler::GetDroppedFrames()));
+  ImGui::Columns(5, "GPUTimings");
+  ImGui::Text("Pass");
+  ImGui::NextColumn();
+  ImGui::Text("Last (ms)");
+  ImGui::NextColumn();
+  ImGui::Text("Min (ms)");
+  ImGui::NextColumn();
+  ImGui::Text("Avg (ms)");
+  ImGui::NextColumn();
+  ImGui::Text("P99 (ms)");
+  ImGui::NextColumn();
+  ImGui::Separator();
+  for (const GPUPassStats& pass : GPUProfiler::GetPassStats()) {
+    ImGui::Text("%s", pass.Name);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", pass.LastMs);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", pass.MinMs);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", pass.AvgMs);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", pass.P99Ms);
+    ImGui::NextColumn();
+  }
+  ImGui::Columns(1);
+  ImGui::End();
+
+#if ONYX_MEMORY_TRACKING
+  ImGui::Begin("Memory");
+  ImGui::Columns(6, "MemoryTags");
+  ImGui::Text("Tag");
+  ImGui::NextColumn();
+  ImGui::Text("Live (KB)");
+  ImGui::NextColumn();
+  ImGui::Text("Peak (KB)");
+  ImGui::NextColumn();
+  ImGui::Text("Allocations");
+  ImGui::NextColumn();
+  ImGui::Text("Per frame");
+  ImGui::NextColumn();
+  ImGui::Text("KB per frame");
+  ImGui::NextColumn();
+  ImGui::Separator();
+  for (size_t i = 0; i < static_cast<size_t>(MemoryTag::Count); ++i) {
+    const MemoryTag tag = static_cast<MemoryTag>(i);
+    const MemoryTagStats stats = MemoryTracker::GetStats(tag);
+    ImGui::Text("%s", MemoryTracker::GetTagName(tag));
+    ImGui::NextColumn();
+    ImGui::Text("%.1f", stats.LiveBytes / 1024.0);
+    ImGui::NextColumn();
+    ImGui::Text("%.1f", stats.PeakBytes / 1024.0);
+    ImGui::NextColumn();
+    ImGui::Text("%llu", static_cast<unsigned long long>(stats.LiveAllocations));
+    ImGui::NextColumn();
+    ImGui::Text("%llu", static_cast<unsigned long long>(stats.FrameAllocations));
+    ImGui::NextColumn();
+    ImGui::Text("%.1f", stats.FrameBytes / 1024.0);
+    ImGui::NextColumn();
+  }
+  ImGui::Columns(1);
+  ImGui::End();
+#endif
+
+  DrawLogConsole();
+}
+
+void ImGuiLayer::DrawLogConsole() {
+  static const char* const levels[] = {"Trace", "Debug", "Info", "Warn", "Error", "Fatal"};
+  static const ImVec4 colors[] = {{0.5f, 0.5f, 0.5f, 1.0f}, {0.6f, 0.8f, 1.0f, 1.0f},
+                                  {0.9f, 0.9f, 0.9f, 1.0f}, {1.0f, 0.8f, 0.2f, 1.0f},
+                                  {1.0f, 0.4f, 0.3f, 1.0f}, {1.0f, 0.2f, 0.6f, 1.0f}};
+
+  ImGui::Begin("Log");
+  ImGui::SetNextItemWidth(100.0f);
+  ImGui::Combo("Level", &m_LogLevel, levels, IM_ARRAYSIZE(levels));
+  ImGui::SameLine();
+  if (ImGui::Button("Clear")) {
+    Log::ClearConsole();
+  }
+  ImGui::SameLine();
+  ImGui::Text("%zu dropped", Log::GetDroppedMessages());
+  ImGui::Separator();
+
+  Log::GetConsoleLines(m_LogLines);
+  m_VisibleLogLines.clear();
+  for (size_t i = 0; i < m_LogLines.size(); ++i) {
+    if (m_LogLines[i].Level >= m_LogLevel) {
+      m_VisibleLogLines.push_back(static_cast<int>(i));
+    }
+  }
+
+  ImGui::BeginChild("LogLines", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
+  // Keep following new lines unless scrolled up.
+  const bool atBottom = ImGui::GetScrollY() >= ImGui::GetScrollMaxY();
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(m_VisibleLogLines.size()));
+  while (clipper.Step()) {
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+      const LogLine& line = m_LogLines[m_VisibleLogLines[i]];
+      const int level = std::min(static_cast<int>(line.Level), IM_ARRAYSIZE(colors) - 1);
+      ImGui::PushStyleColor(ImGuiCol_Text, colors[level]);
+      ImGui::TextUnformatted(line.Text.data(), line.Text.data() + line.Text.size());
+      ImGui::PopStyleColor();
+    }
+  }
+  if (atBottom) {
+    ImGui::SetScrollHereY(1.0f);
+  }
+  ImGui::EndChild();
+  ImGui::End();
 }
 
 void ImGuiLayer::Begin() {
+  ONYX_PROFILE_FUNCTION();
+
   // TODO: Renderer platform choosing
-  ImGui_ImplOpenGL3_NewFrame();
-#ifdef ONYX_PLATFORM_WINDOWS
-  ImGui_ImplGlfw_NewFrame();
-#endif
+  Renderer::Submit([]() { ImGui_ImplOpenGL3_NewFrame(); });
+  if (m_Headless) {
+    // Normally filled in by the platform backend.
+    ImGuiIO& io = ImGui::GetIO();
+    Scope<Window>& win = Application::Get().GetWindow();
+    io.DisplaySize =
+        ImVec2(static_cast<float>(win->GetWidth()), static_cast<float>(win->GetHeight()));
+    io.DeltaTime = std::max(Application::Get().GetFrameTimestep().GetSeconds(), 1e-6f);
+  } else {
+    ImGui_ImplGlfw_NewFrame();
+  }
   ImGui::NewFrame();
 }
 
 void ImGuiLayer::End() {
+  ONYX_PROFILE_FUNCTION();
+
   ImGuiIO& io = ImGui::GetIO();
   Application& app = Application::Get();
   Scope<Window>& win = app.GetWindow();
@@ -79,15 +344,22 @@ void ImGuiLayer::End() {
 
   ImGui::Render();
   // TODO: Renderer platform choosing
-  ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+  {
+    GPUPassScope pass("ImGui");
+    if (Renderer::IsThreaded()) {
+      ImGuiDrawSnapshot* snapshot = m_Snapshots[m_NextSnapshot++ % m_Snapshots.size()].get();
+      snapshot->Capture(*ImGui::GetDrawData());
+      Renderer::Submit([snapshot]() { ImGui_ImplOpenGL3_RenderDrawData(&snapshot->DrawData); });
+    } else {
+      Renderer::Submit([]() { ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData()); });
+    }
+  }
 
   if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) {
-#ifdef ONYX_PLATFORM_WINDOWS
     GLFWwindow* backupContext = glfwGetCurrentContext();
     ImGui::UpdatePlatformWindows();
     ImGui::RenderPlatformWindowsDefault();
     glfwMakeContextCurrent(backupContext);
-#endif
   }
 }
 }  // namespace Onyx
\ No newline at end of file
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <string>
+#include <vector>
+
 #include "Onyx/Core.h"
 #include "Onyx/Layer.h"
+#include "Onyx/Log.h"
 
 namespace Onyx {
 class MouseMovedEvent;
@@ -13,10 +17,13 @@ class KeyReleasedEvent;
 class KeyTypedEvent;
 class WindowResizedEvent;
 
+struct ImGuiDrawSnapshot;
+
 class ONYX_API ImGuiLayer final : public Layer {
  public:
-  ImGuiLayer() = default;
-  ~ImGuiLayer() = default;
+  // Baked font atlases are cached in fontCacheDirectory, or rebuilt every run if it is empty.
+  explicit ImGuiLayer(const std::string& fontCacheDirectory = std::string());
+  ~ImGuiLayer();
 
   void OnAttach() override;
   void OnDetach() override;
@@ -24,5 +31,18 @@ class ONYX_API ImGuiLayer final : public Layer {
 
   void Begin();
   void End();
+
+ private:
+  void DrawLogConsole();
+
+  std::string m_FontCacheDirectory;
+  bool m_Headless = false;
+  // Copies of the draw data for frames still queued on the render thread.
+  std::vector<Scope<ImGuiDrawSnapshot>> m_Snapshots;
+  size_t m_NextSnapshot = 0;
+  // Reused every frame so drawing the console doesn't allocate once the log has filled up.
+  std::vector<LogLine> m_LogLines;
+  std::vector<int> m_VisibleLogLines;
+  int m_LogLevel = 0;
 };
 }  // namespace Onyx
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "pch.h"
+
+#include "Input.h"
+
+#include "Onyx/Events/KeyEvent.h"
+#include "Onyx/Events/MouseEvent.h"
+
+namespace Onyx {
+InputSnapshot Input::s_Snapshot;
+
+// Collects the current frame's events, main thread only.
+static InputSnapshot s_Pending;
+static float s_LastMouseX = 0.0f;
+static float s_LastMouseY = 0.0f;
+
+template <size_t N>
+static void SetDown(std::bitset<N>& down, std::bitset<N>& pressed, unsigned int code) {
+  // Held keys repeat their press event, which isn't a new press.
+  if (code < N && !down.test(code)) {
+    down.set(code);
+    pressed.set(code);
+  }
+}
+
+template <size_t N>
+static void SetUp(std::bitset<N>& down, std::bitset<N>& released, unsigned int code) {
+  if (code < N && down.test(code)) {
+    down.reset(code);
+    released.set(code);
+  }
+}
+
+void Input::OnEvent(const Event& e) {
+  switch (e.GetEventType()) {
+    case EventType::KeyPressed:
+      SetDown(s_Pending.m_KeysDown, s_Pending.m_KeysPressed,
+              static_cast<const KeyPressedEvent&>(e).KeyCode);
+      break;
+    case EventType::KeyReleased:
+      SetUp(s_Pending.m_KeysDown, s_Pending.m_KeysReleased,
+            static_cast<const KeyReleasedEvent&>(e).KeyCode);
+      break;
+    case EventType::MousePressed:
+      SetDown(s_Pending.m_ButtonsDown, s_Pending.m_ButtonsPressed,
+              static_cast<const MousePressedEvent&>(e).Button);
+      break;
+    case EventType::MouseReleased:
+      SetUp(s_Pending.m_ButtonsDown, s_Pending.m_ButtonsReleased,
+            static_cast<const MouseReleasedEvent&>(e).Button);
+      break;
+    case EventType::MouseMoved: {
+      const auto& moved = static_cast<const MouseMovedEvent&>(e);
+      s_Pending.m_MouseX = static_cast<float>(moved.X);
+      s_Pending.m_MouseY = static_cast<float>(moved.Y);
+      break;
+    }
+    case EventType::MouseScrolled: {
+      const auto& scrolled = static_cast<const MouseScrolledEvent&>(e);
+      s_Pending.m_ScrollDelta += static_cast<float>(scrolled.Offset);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+void Input::EndFrame() {
+  s_Pending.m_MouseDeltaX = s_Pending.m_MouseX - s_LastMouseX;
+  s_Pending.m_MouseDeltaY = s_Pending.m_MouseY - s_LastMouseY;
+  s_LastMouseX = s_Pending.m_MouseX;
+  s_LastMouseY = s_Pending.m_MouseY;
+  s_Snapshot = s_Pending;
+
+  s_Pending.m_KeysPressed.reset();
+  s_Pending.m_KeysReleased.reset();
+  s_Pending.m_ButtonsPressed.reset();
+  s_Pending.m_ButtonsReleased.reset();
+  s_Pending.m_ScrollDelta = 0.0f;
+}
+}  // namespace Onyx
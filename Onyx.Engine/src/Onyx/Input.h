@@ -1,16 +1,83 @@
 #pragma once
 
+#include <bitset>
+
 #include "Onyx/Core.h"
+#include "Onyx/Events/Event.h"
 #include "Onyx/KeyCodes.h"
 #include "Onyx/MouseButtonCodes.h"
 
 namespace Onyx {
+// Keyboard and mouse state as of one frame, built from that frame's events. "Pressed" and
+// "released" cover transitions during the frame, so a key tapped between two frames reports both
+// while never being down.
+class ONYX_API InputSnapshot final {
+ public:
+  bool IsKeyDown(Key key) const { return Test(m_KeysDown, key); }
+  bool IsKeyPressed(Key key) const { return Test(m_KeysPressed, key); }
+  bool IsKeyReleased(Key key) const { return Test(m_KeysReleased, key); }
+
+  bool IsMouseDown(MouseButton button) const { return Test(m_ButtonsDown, button); }
+  bool IsMousePressed(MouseButton button) const { return Test(m_ButtonsPressed, button); }
+  bool IsMouseReleased(MouseButton button) const { return Test(m_ButtonsReleased, button); }
+
+  float GetMouseX() const { return m_MouseX; }
+  float GetMouseY() const { return m_MouseY; }
+  // Cursor movement and scrolling during the frame.
+  float GetMouseDeltaX() const { return m_MouseDeltaX; }
+  float GetMouseDeltaY() const { return m_MouseDeltaY; }
+  float GetScrollDelta() const { return m_ScrollDelta; }
+
+ private:
+  friend class Input;
+
+  template <size_t N, typename Code>
+  static bool Test(const std::bitset<N>& bits, Code code) {
+    const auto index = static_cast<size_t>(code);
+    return index < N && bits.test(index);
+  }
+
+  std::bitset<KeyCount> m_KeysDown;
+  std::bitset<KeyCount> m_KeysPressed;
+  std::bitset<KeyCount> m_KeysReleased;
+  std::bitset<MouseButtonCount> m_ButtonsDown;
+  std::bitset<MouseButtonCount> m_ButtonsPressed;
+  std::bitset<MouseButtonCount> m_ButtonsReleased;
+  float m_MouseX = 0.0f;
+  float m_MouseY = 0.0f;
+  float m_MouseDeltaX = 0.0f;
+  float m_MouseDeltaY = 0.0f;
+  float m_ScrollDelta = 0.0f;
+};
+
+// Input as of the current frame. The application feeds every event to OnEvent while dispatching
+// and publishes the result with EndFrame, before any layer updates. The published snapshot
+// doesn't change until the next frame's EndFrame, so jobs may read it as long as they are waited
+// on within the frame; work that lives longer should keep a copy.
 class ONYX_API Input final {
  public:
-  static bool IsKeyPressed(Key keycode);
-  static bool IsMousePressed(MouseButton button);
-  static void GetMousePos(float* x, float* y);
-  static float GetMouseX();
-  static float GetMouseY();
+  static bool IsKeyDown(Key key) { return s_Snapshot.IsKeyDown(key); }
+  static bool IsKeyPressed(Key key) { return s_Snapshot.IsKeyPressed(key); }
+  static bool IsKeyReleased(Key key) { return s_Snapshot.IsKeyReleased(key); }
+
+  static bool IsMouseDown(MouseButton button) { return s_Snapshot.IsMouseDown(button); }
+  static bool IsMousePressed(MouseButton button) { return s_Snapshot.IsMousePressed(button); }
+  static bool IsMouseReleased(MouseButton button) { return s_Snapshot.IsMouseReleased(button); }
+
+  static void GetMousePos(float* x, float* y) {
+    *x = s_Snapshot.GetMouseX();
+    *y = s_Snapshot.GetMouseY();
+  }
+  static float GetMouseX() { return s_Snapshot.GetMouseX(); }
+  static float GetMouseY() { return s_Snapshot.GetMouseY(); }
+  static float GetScrollDelta() { return s_Snapshot.GetScrollDelta(); }
+
+  static const InputSnapshot& GetSnapshot() { return s_Snapshot; }
+
+  static void OnEvent(const Event& e);
+  static void EndFrame();
+
+ private:
+  static InputSnapshot s_Snapshot;
 };
-}  // namespace Onyx
\ No newline at end of file
+}  // namespace Onyx
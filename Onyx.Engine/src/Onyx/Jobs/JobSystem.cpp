@@ -0,0 +1,286 @@
+#include "pch.h"
+
+#include "JobSystem.h"
+
+#include <random>
+#include <string>
+#include <thread>
+
+#include "Onyx/Debug/MemoryTracker.h"
+#include "Onyx/Debug/Profiler.h"
+
+namespace Onyx {
+// Ring of job slots owned by a single submitting thread. When the thread has Capacity jobs in
+// flight, submitting another one runs other jobs until the oldest slot has been freed.
+struct JobPool {
+  static constexpr uint32_t Capacity = 4096;
+
+  Job Jobs[Capacity];
+  uint32_t Next = 0;
+};
+
+// Chase-Lev work-stealing deque (Le et al., "Correct and Efficient Work-Stealing for Weak Memory
+// Models"). Only the owning worker pushes and pops at the bottom, any thread may steal from the
+// top.
+class JobDeque final {
+ public:
+  static constexpr int64_t Capacity = 4096;
+
+  bool Push(Job* job) {
+    const int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+    const int64_t top = m_Top.load(std::memory_order_acquire);
+    if (bottom - top >= Capacity) {
+      return false;
+    }
+
+    m_Jobs[bottom & (Capacity - 1)].store(job, std::memory_order_relaxed);
+    m_Bottom.store(bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  Job* Pop() {
+    const int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    m_Bottom.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = m_Top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    Job* job = m_Jobs[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+    if (top == bottom) {
+      // Last job, race any thieves for it.
+      if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+        job = nullptr;
+      }
+      m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return job;
+  }
+
+  Job* Steal() {
+    int64_t top = m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+
+    Job* job = m_Jobs[top & (Capacity - 1)].load(std::memory_order_relaxed);
+    if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      return nullptr;
+    }
+
+    return job;
+  }
+
+ private:
+  alignas(64) std::atomic<int64_t> m_Top{0};
+  alignas(64) std::atomic<int64_t> m_Bottom{0};
+  std::atomic<Job*> m_Jobs[Capacity];
+};
+
+struct JobWorker {
+  JobDeque Queue;
+  JobPool Pool;
+  std::thread Thread;
+};
+
+// Identifies the calling thread's worker slot, for the job system it belongs to.
+static thread_local JobSystem* t_Owner = nullptr;
+static thread_local unsigned int t_WorkerIndex = 0;
+static thread_local JobPool* t_ExternalPool = nullptr;
+
+JobSystem::JobSystem(unsigned int workerCount) {
+  if (workerCount == 0) {
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+  }
+  OnyxInfo("Starting job system with {} workers", workerCount);
+
+  m_Workers.reserve(workerCount + 1);
+  for (unsigned int i = 0; i <= workerCount; ++i) {
+    m_Workers.emplace_back(CreateScope<JobWorker>());
+  }
+
+  t_Owner = this;
+  t_WorkerIndex = 0;
+  for (unsigned int i = 1; i <= workerCount; ++i) {
+    m_Workers[i]->Thread = std::thread([this, i]() { WorkerMain(i); });
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(m_SleepMutex);
+    m_Running.store(false);
+  }
+  m_SleepCondition.notify_all();
+
+  for (size_t i = 1; i < m_Workers.size(); ++i) {
+    m_Workers[i]->Thread.join();
+  }
+  if (t_Owner == this) {
+    t_Owner = nullptr;
+  }
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+  ONYX_PROFILE_FUNCTION();
+
+  while (!counter.IsDone()) {
+    if (!RunOneJob()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+Job* JobSystem::AllocateJob() {
+  JobPool* pool = nullptr;
+  if (t_Owner == this) {
+    pool = &m_Workers[t_WorkerIndex]->Pool;
+  } else {
+    if (!t_ExternalPool) {
+      std::lock_guard<std::mutex> lock(m_ExternalMutex);
+      m_ExternalPools.emplace_back(CreateScope<JobPool>());
+      t_ExternalPool = m_ExternalPools.back().get();
+    }
+    pool = t_ExternalPool;
+  }
+
+  for (;;) {
+    // Jobs run while helping may submit jobs of their own, so the slot is picked anew every time.
+    Job* job = &pool->Jobs[pool->Next % JobPool::Capacity];
+    if (!job->Invoke.load(std::memory_order_acquire)) {
+      pool->Next++;
+      return job;
+    }
+    if (!RunOneJob()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobSystem::Submit(Job* job, JobCounter* counter) {
+  job->Counter = counter;
+  if (counter) {
+    counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (t_Owner != this || !m_Workers[t_WorkerIndex]->Queue.Push(job)) {
+    Enqueue(job);
+    return;
+  }
+
+  m_QueuedJobs.fetch_add(1);
+  if (m_SleepingWorkers.load() > 0) {
+    std::lock_guard<std::mutex> lock(m_SleepMutex);
+    m_SleepCondition.notify_one();
+  }
+}
+
+void JobSystem::Enqueue(Job* job) {
+  {
+    std::lock_guard<std::mutex> lock(m_ExternalMutex);
+    m_ExternalQueue.push_back(job);
+  }
+
+  // Queue first, then count, so a woken worker is guaranteed to find something.
+  m_QueuedJobs.fetch_add(1);
+  if (m_SleepingWorkers.load() > 0) {
+    std::lock_guard<std::mutex> lock(m_SleepMutex);
+    m_SleepCondition.notify_one();
+  }
+}
+
+Job* JobSystem::FindJob() {
+  const bool isWorker = t_Owner == this;
+  if (isWorker) {
+    if (Job* job = m_Workers[t_WorkerIndex]->Queue.Pop()) {
+      return job;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_ExternalMutex);
+    if (!m_ExternalQueue.empty()) {
+      Job* job = m_ExternalQueue.front();
+      m_ExternalQueue.pop_front();
+      return job;
+    }
+  }
+
+  // Start at a random victim so thieves don't all pile onto the same worker.
+  static thread_local std::minstd_rand random(std::random_device{}());
+  const size_t workerCount = m_Workers.size();
+  const size_t start = random() % workerCount;
+  for (size_t i = 0; i < workerCount; ++i) {
+    const size_t victim = (start + i) % workerCount;
+    if (isWorker && victim == t_WorkerIndex) {
+      continue;
+    }
+    if (Job* job = m_Workers[victim]->Queue.Steal()) {
+      return job;
+    }
+  }
+
+  return nullptr;
+}
+
+bool JobSystem::RunOneJob() {
+  Job* job = FindJob();
+  if (!job) {
+    return false;
+  }
+  m_QueuedJobs.fetch_sub(1);
+
+  if (job->Dependency && !job->Dependency->IsDone()) {
+    // Not ready yet, put it at the back of the shared queue so the jobs it depends on get to run.
+    Enqueue(job);
+    return false;
+  }
+
+  Execute(job);
+  return true;
+}
+
+void JobSystem::Execute(Job* job) {
+  JobCounter* counter = job->Counter;
+  job->Invoke.load(std::memory_order_relaxed)(*job);
+  if (counter) {
+    counter->m_Count.fetch_sub(1, std::memory_order_release);
+  }
+  job->Invoke.store(nullptr, std::memory_order_release);
+}
+
+void JobSystem::WorkerMain(unsigned int index) {
+  t_Owner = this;
+  t_WorkerIndex = index;
+#if ONYX_PROFILE
+  const std::string name = "Worker " + std::to_string(index);
+  ONYX_PROFILE_THREAD(name.c_str());
+#endif
+  ONYX_MEMORY_THREAD_TAG(Jobs);
+
+  while (m_Running.load(std::memory_order_relaxed)) {
+    if (RunOneJob()) {
+      continue;
+    }
+    if (m_QueuedJobs.load() > 0) {
+      // Jobs exist but are blocked or were taken first, try again shortly.
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_SleepMutex);
+    m_SleepingWorkers.fetch_add(1);
+    m_SleepCondition.wait(lock, [this]() { return m_QueuedJobs.load() > 0 || !m_Running.load(); });
+    m_SleepingWorkers.fetch_sub(1);
+  }
+}
+}  // namespace Onyx
\ No newline at end of file
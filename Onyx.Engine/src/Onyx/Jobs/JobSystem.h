@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+// Number of jobs still in flight. A counter may be reused once it has reached zero.
+class JobCounter final {
+ public:
+  JobCounter() = default;
+  JobCounter(const JobCounter&) = delete;
+  JobCounter& operator=(const JobCounter&) = delete;
+
+  bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+
+ private:
+  friend class JobSystem;
+
+  std::atomic<uint32_t> m_Count{0};
+};
+
+// A unit of work with its callable stored inline, so submitting a job never allocates. Invoke is
+// cleared once the job has run, which frees the slot for reuse.
+struct Job {
+  static constexpr size_t StorageSize = 64 - 3 * sizeof(void*);
+
+  std::atomic<void (*)(Job& job)> Invoke{nullptr};
+  JobCounter* Counter = nullptr;
+  const JobCounter* Dependency = nullptr;
+  alignas(void*) unsigned char Storage[StorageSize];
+};
+
+struct JobWorker;
+struct JobPool;
+
+// Work-stealing scheduler with one worker thread per spare core. Every worker owns a lock-free
+// deque; it runs its own jobs newest first and steals the oldest jobs of others when it runs dry.
+// The thread that creates the JobSystem acts as an extra worker whenever it waits on a counter.
+class ONYX_API JobSystem final {
+ public:
+  // workerCount of zero picks one worker per hardware thread, minus the calling thread.
+  explicit JobSystem(unsigned int workerCount = 0);
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+
+  // Queues fn to run on any worker. If counter is given, it is incremented now and decremented
+  // once fn returns. If dependency is given, fn will not start before it reaches zero.
+  template <typename F>
+  void Run(F&& fn, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr);
+
+  // Calls fn(begin, end) over [0, count) split into batches of at most batchSize, and returns once
+  // every batch has completed.
+  template <typename F>
+  void ParallelFor(uint32_t count, uint32_t batchSize, F&& fn);
+
+  // Runs other jobs until counter reaches zero.
+  void Wait(const JobCounter& counter);
+
+  // Worker threads, not counting the thread that created the job system.
+  unsigned int GetWorkerCount() const { return static_cast<unsigned int>(m_Workers.size()) - 1; }
+
+ private:
+  Job* AllocateJob();
+  void Submit(Job* job, JobCounter* counter);
+  void Enqueue(Job* job);
+  Job* FindJob();
+  bool RunOneJob();
+  void Execute(Job* job);
+  void WorkerMain(unsigned int index);
+
+  std::vector<Scope<JobWorker>> m_Workers;  // Index 0 is the creating thread.
+  std::vector<Scope<JobPool>> m_ExternalPools;
+  // Jobs submitted from threads that aren't workers, and jobs waiting on a dependency.
+  std::deque<Job*> m_ExternalQueue;
+  std::mutex m_ExternalMutex;
+
+  std::atomic<bool> m_Running{true};
+  std::atomic<uint32_t> m_QueuedJobs{0};
+  std::atomic<uint32_t> m_SleepingWorkers{0};
+  std::mutex m_SleepMutex;
+  std::condition_variable m_SleepCondition;
+};
+
+template <typename F>
+void JobSystem::Run(F&& fn, JobCounter* counter, const JobCounter* dependency) {
+  using Callable = std::decay_t<F>;
+  static_assert(sizeof(Callable) <= Job::StorageSize,
+                "Job captures too much state, capture a pointer to it instead");
+  static_assert(alignof(Callable) <= alignof(void*), "Job callable is over-aligned");
+
+  Job* job = AllocateJob();
+  new (job->Storage) Callable(std::forward<F>(fn));
+  job->Invoke.store(
+      [](Job& job) {
+        Callable* callable = std::launder(reinterpret_cast<Callable*>(job.Storage));
+        (*callable)();
+        callable->~Callable();
+      },
+      std::memory_order_relaxed);
+  job->Dependency = dependency;
+  Submit(job, counter);
+}
+
+template <typename F>
+void JobSystem::ParallelFor(uint32_t count, uint32_t batchSize, F&& fn) {
+  if (count == 0) {
+    return;
+  }
+
+  batchSize = std::max(batchSize, 1u);
+  JobCounter counter;
+  for (uint32_t begin = 0; begin < count; begin += batchSize) {
+    const uint32_t end = std::min(begin + batchSize, count);
+    Run([&fn, begin, end]() { fn(begin, end); }, &counter);
+  }
+  Wait(counter);
+}
+}  // namespace Onyx
\ No newline at end of file
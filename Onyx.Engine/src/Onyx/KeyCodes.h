@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace Onyx {
 enum class Key {
   SPACE = 32,
@@ -123,6 +125,8 @@ enum class Key {
   RIGHT_SUPER = 347,
   MENU = 348
 };
+
+constexpr size_t KeyCount = static_cast<size_t>(Key::MENU) + 1;
 }
 
 /* Function keys */
@@ -1,18 +1,50 @@
 #pragma once
 
+#include <vector>
+
 #include "Onyx/Core.h"
 #include "Onyx/Events/Event.h"
+#include "Onyx/Events/EventDispatcher.h"
+#include "Onyx/Timestep.h"
 
 namespace Onyx {
 class ONYX_API Layer {
  public:
-  Layer() = default;
+  Layer(const char* name = "Layer") : m_Name(name) {}
   virtual ~Layer() = default;
 
   virtual void OnAttach() {}
   virtual void OnDetach() {}
-  virtual void OnUpdate() {}
-  virtual bool OnEvent(const Event& e) { return false; }
+  // Called zero or more times per frame at ApplicationSettings::FixedUpdateRate, for simulation
+  // that must not depend on the frame rate.
+  virtual void OnFixedUpdate(Timestep ts) {}
+  // Called once per frame with the time elapsed since the previous frame. Rendering of simulated
+  // state should be interpolated using Application::GetInterpolationAlpha().
+  virtual void OnUpdate(Timestep ts) {}
   virtual void OnImGuiRender() {}
+
+  const char* GetName() const { return m_Name; }
+  const std::vector<EventSubscription>& GetSubscriptions() const { return m_Subscriptions; }
+
+ protected:
+  // Registers a handler such as `bool MyLayer::OnKeyPressed(const KeyPressedEvent&)`, to be called
+  // from OnAttach. Layers only receive the event types they subscribed to. Returning true from the
+  // handler stops the event from reaching the layers below. Subscriptions are dropped when the
+  // layer is detached, so a layer pushed again subscribes afresh.
+  template <auto Method>
+  void Subscribe() {
+    using Traits = EventHandlerTraits<decltype(Method)>;
+    static_assert(std::is_base_of<Layer, typename Traits::Class>::value,
+                  "Handler must be a member of this layer");
+    auto* instance = static_cast<typename Traits::Class*>(this);
+    m_Subscriptions.push_back(
+        {EventTypeIndex<typename Traits::EventT>(), MakeEventHandler<Method>(instance)});
+  }
+
+ private:
+  friend class LayerStack;
+
+  const char* m_Name;
+  std::vector<EventSubscription> m_Subscriptions;
 };
 }  // namespace Onyx
\ No newline at end of file
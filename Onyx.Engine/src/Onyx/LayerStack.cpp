@@ -0,0 +1,138 @@
+#include "pch.h"
+
+#include "LayerStack.h"
+
+#include <chrono>
+
+#include "Onyx/Debug/Profiler.h"
+
+namespace Onyx {
+using LayerClock = std::chrono::steady_clock;
+
+static float ElapsedMs(LayerClock::time_point start) {
+  return std::chrono::duration<float, std::milli>(LayerClock::now() - start).count();
+}
+
+LayerStack::~LayerStack() { Clear(); }
+
+void LayerStack::Clear() {
+  for (auto it = m_Layers.rbegin(); it != m_Layers.rend(); ++it) {
+    (*it)->OnDetach();
+    (*it)->m_Subscriptions.clear();
+  }
+  m_Layers.clear();
+  m_Timings.clear();
+  m_Owners.clear();
+  m_Pending.clear();
+  m_LayerInsertIndex = 0;
+}
+
+void LayerStack::PushLayer(Ref<Layer> layer) {
+  m_Pending.push_back({Operation::PushLayer, std::move(layer)});
+}
+
+void LayerStack::PushOverlay(Ref<Layer> overlay) {
+  m_Pending.push_back({Operation::PushOverlay, std::move(overlay)});
+}
+
+void LayerStack::PopLayer(Ref<Layer> layer) {
+  m_Pending.push_back({Operation::PopLayer, std::move(layer)});
+}
+
+void LayerStack::PopOverlay(Ref<Layer> overlay) {
+  m_Pending.push_back({Operation::PopOverlay, std::move(overlay)});
+}
+
+bool LayerStack::BeginFrame() {
+  for (LayerTiming& timing : m_Timings) {
+    timing.FixedUpdateMs = 0.0f;
+  }
+
+  if (m_Pending.empty()) {
+    return false;
+  }
+
+  ONYX_PROFILE_FUNCTION();
+
+  // Attaching a layer may queue more operations, so take the current batch out first.
+  std::vector<PendingOperation> pending;
+  pending.swap(m_Pending);
+
+  for (PendingOperation& op : pending) {
+    switch (op.Op) {
+      case Operation::PushLayer:
+        Insert(m_LayerInsertIndex, op.Target);
+        m_LayerInsertIndex++;
+        break;
+      case Operation::PushOverlay:
+        Insert(m_Layers.size(), op.Target);
+        break;
+      case Operation::PopLayer:
+        if (Remove(0, m_LayerInsertIndex, op.Target)) {
+          m_LayerInsertIndex--;
+        }
+        break;
+      case Operation::PopOverlay:
+        Remove(m_LayerInsertIndex, m_Layers.size(), op.Target);
+        break;
+    }
+  }
+
+  // Reuse the allocation for the next batch.
+  if (m_Pending.empty()) {
+    pending.clear();
+    m_Pending.swap(pending);
+  }
+
+  return true;
+}
+
+void LayerStack::OnFixedUpdate(Timestep ts) {
+  for (size_t i = 0; i < m_Layers.size(); ++i) {
+    const LayerClock::time_point start = LayerClock::now();
+    m_Layers[i]->OnFixedUpdate(ts);
+    m_Timings[i].FixedUpdateMs += ElapsedMs(start);
+  }
+}
+
+void LayerStack::OnUpdate(Timestep ts) {
+  for (size_t i = 0; i < m_Layers.size(); ++i) {
+    const LayerClock::time_point start = LayerClock::now();
+    m_Layers[i]->OnUpdate(ts);
+    m_Timings[i].UpdateMs = ElapsedMs(start);
+  }
+}
+
+void LayerStack::OnImGuiRender() {
+  for (size_t i = 0; i < m_Layers.size(); ++i) {
+    const LayerClock::time_point start = LayerClock::now();
+    m_Layers[i]->OnImGuiRender();
+    m_Timings[i].ImGuiRenderMs = ElapsedMs(start);
+  }
+}
+
+void LayerStack::Insert(size_t index, Ref<Layer> layer) {
+  m_Layers.insert(m_Layers.begin() + index, layer.get());
+  m_Timings.insert(m_Timings.begin() + index, LayerTiming());
+  m_Owners.insert(m_Owners.begin() + index, layer);
+  layer->OnAttach();
+}
+
+bool LayerStack::Remove(size_t first, size_t last, const Ref<Layer>& layer) {
+  auto begin = m_Layers.begin() + first;
+  auto end = m_Layers.begin() + last;
+  auto it = std::find(begin, end, layer.get());
+  if (it == end) {
+    return false;
+  }
+
+  const size_t index = it - m_Layers.begin();
+  layer->OnDetach();
+  layer->m_Subscriptions.clear();
+  m_Layers.erase(it);
+  m_Timings.erase(m_Timings.begin() + index);
+  m_Owners.erase(m_Owners.begin() + index);
+
+  return true;
+}
+}  // namespace Onyx
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <iterator>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Layer.h"
+#include "Onyx/Timestep.h"
+
+namespace Onyx {
+// Time spent in each callback of a layer during the last frame.
+struct LayerTiming {
+  float FixedUpdateMs = 0.0f;
+  float UpdateMs = 0.0f;
+  float ImGuiRenderMs = 0.0f;
+};
+
+// Ordered list of layers, with overlays always above regular layers. Layers are kept as a
+// contiguous array of raw pointers for iteration, ownership lives in a separate array that the
+// frame loop never touches. Pushes and pops are queued and only take effect in BeginFrame(), so a
+// layer may push or pop layers from its own callbacks.
+class ONYX_API LayerStack final {
+ public:
+  LayerStack() = default;
+  ~LayerStack();
+
+  LayerStack(const LayerStack&) = delete;
+  LayerStack& operator=(const LayerStack&) = delete;
+
+  void PushLayer(Ref<Layer> layer);
+  void PushOverlay(Ref<Layer> overlay);
+  void PopLayer(Ref<Layer> layer);
+  void PopOverlay(Ref<Layer> overlay);
+
+  // Attaches and detaches queued layers and resets the frame's timings, to be called at the start
+  // of every frame. Returns whether the stack changed.
+  bool BeginFrame();
+  // Detaches every layer, top to bottom, and drops any queued operations.
+  void Clear();
+
+  // Run a callback on every layer, bottom to top, recording how long each one took.
+  void OnFixedUpdate(Timestep ts);
+  void OnUpdate(Timestep ts);
+  void OnImGuiRender();
+
+  size_t Size() const { return m_Layers.size(); }
+  Layer* const* begin() const { return m_Layers.data(); }
+  Layer* const* end() const { return m_Layers.data() + m_Layers.size(); }
+  std::reverse_iterator<Layer* const*> rbegin() const { return std::make_reverse_iterator(end()); }
+  std::reverse_iterator<Layer* const*> rend() const { return std::make_reverse_iterator(begin()); }
+  const LayerTiming& GetTiming(size_t index) const { return m_Timings[index]; }
+
+ private:
+  enum class Operation { PushLayer, PushOverlay, PopLayer, PopOverlay };
+  struct PendingOperation {
+    Operation Op;
+    Ref<Layer> Target;
+  };
+
+  void Insert(size_t index, Ref<Layer> layer);
+  bool Remove(size_t first, size_t last, const Ref<Layer>& layer);
+
+  std::vector<Layer*> m_Layers;
+  std::vector<LayerTiming> m_Timings;
+  std::vector<Ref<Layer>> m_Owners;
+  std::vector<PendingOperation> m_Pending;
+  size_t m_LayerInsertIndex = 0;
+};
+}  // namespace Onyx
\ No newline at end of file
@@ -2,14 +2,160 @@
 
 #include "Log.h"
 
+#include <spdlog/async.h>
+#include <spdlog/pattern_formatter.h>
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+
 namespace Onyx {
+// Keeps the most recent lines in a ring for the ImGui console. Lines are overwritten in place,
+// so once the ring has filled up their storage is reused.
+class LogConsoleSink final : public spdlog::sinks::base_sink<std::mutex> {
+ public:
+  explicit LogConsoleSink(size_t capacity) : m_Lines(capacity) {}
+
+  void CopyLines(std::vector<LogLine>& out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const size_t count = std::min(m_Count, m_Lines.size());
+    out.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+      const LogLine& line = m_Lines[(m_Count - count + i) % m_Lines.size()];
+      out[i].Level = line.Level;
+      out[i].Text.assign(line.Text);
+    }
+  }
+
+  void Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    m_Count = 0;
+  }
+
+ protected:
+  void sink_it_(const spdlog::details::log_msg& msg) override {
+    spdlog::memory_buf_t formatted;
+    formatter_->format(msg, formatted);
+    LogLine& line = m_Lines[m_Count++ % m_Lines.size()];
+    line.Level = msg.level;
+    line.Text.assign(formatted.data(), formatted.size());
+  }
+
+  void flush_() override {}
+
+ private:
+  std::vector<LogLine> m_Lines;
+  size_t m_Count = 0;
+};
+
 static Ref<spdlog::logger> s_Logger;
+static Ref<LogConsoleSink> s_Console;
+
+void Log::Init(const LogSettings& settings) {
+  std::vector<spdlog::sink_ptr> sinks;
+  auto terminal = CreateRef<spdlog::sinks::stdout_color_sink_mt>();
+  terminal->set_pattern("%^[%T] %l: %v%$");
+  sinks.push_back(terminal);
+
+  // The file may not be writable, which is reported once the logger exists.
+  std::string fileError;
+  if (!settings.FilePath.empty()) {
+    try {
+      spdlog::sink_ptr file;
+      if (settings.RotateBytes > 0) {
+        file = CreateRef<spdlog::sinks::rotating_file_sink_mt>(
+            settings.FilePath, settings.RotateBytes, settings.RotateFiles);
+      } else {
+        file = CreateRef<spdlog::sinks::basic_file_sink_mt>(settings.FilePath, true);
+      }
+      file->set_pattern("[%Y-%m-%d %T.%e] [%t] %l: %v");
+      sinks.push_back(file);
+    } catch (const spdlog::spdlog_ex& e) {
+      fileError = e.what();
+    }
+  }
+
+  if (settings.ConsoleLines > 0) {
+    s_Console = CreateRef<LogConsoleSink>(settings.ConsoleLines);
+    s_Console->set_formatter(CreateScope<spdlog::pattern_formatter>(
+        "[%T] %v", spdlog::pattern_time_type::local, std::string()));
+    sinks.push_back(s_Console);
+  }
+
+  if (settings.Async) {
+    spdlog::init_thread_pool(settings.QueueSize, 1);
+    const spdlog::async_overflow_policy policy =
+        settings.OverflowPolicy == LogOverflowPolicy::Block
+            ? spdlog::async_overflow_policy::block
+            : spdlog::async_overflow_policy::overrun_oldest;
+    s_Logger = CreateRef<spdlog::async_logger>("Core", sinks.begin(), sinks.end(),
+                                               spdlog::thread_pool(), policy);
+  } else {
+    s_Logger = CreateRef<spdlog::logger>("Core", sinks.begin(), sinks.end());
+  }
+  s_Logger->set_level(settings.Level);
+  s_Logger->flush_on(spdlog::level::warn);
+  spdlog::register_logger(s_Logger);
+  spdlog::flush_every(std::chrono::seconds(1));
 
-void Log::Init() {
-  spdlog::set_pattern("%^[%T] %l: %v%$");
-  s_Logger = spdlog::stdout_color_mt("Core");
-  s_Logger->set_level(spdlog::level::trace);
+  if (!fileError.empty()) {
+    OnyxWarn("Not logging to '{}': {}", settings.FilePath, fileError);
+  }
+}
+
+void Log::Shutdown() {
+  if (!s_Logger) {
+    return;
+  }
+
+  Flush();
+  s_Logger.reset();
+  s_Console.reset();
+  spdlog::shutdown();
+}
+
+void Log::Flush() {
+  if (!s_Logger) {
+    return;
+  }
+
+  // An async flush only queues a request, so wait for the queue to drain, after which the last
+  // message is at most being written, and flush the sinks once that is done. The wait is bounded
+  // so a stuck or dead logging thread can't hang an assert or shutdown.
+  s_Logger->flush();
+  if (std::shared_ptr<spdlog::details::thread_pool> pool = spdlog::thread_pool()) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (pool->queue_size() > 0 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    for (const spdlog::sink_ptr& sink : s_Logger->sinks()) {
+      sink->flush();
+    }
+  }
 }
 
 Ref<spdlog::logger>& Log::GetLogger() { return s_Logger; }
-}  // namespace Onyx
\ No newline at end of file
+
+void Log::GetConsoleLines(std::vector<LogLine>& out) {
+  if (s_Console) {
+    s_Console->CopyLines(out);
+  } else {
+    out.clear();
+  }
+}
+
+void Log::ClearConsole() {
+  if (s_Console) {
+    s_Console->Clear();
+  }
+}
+
+size_t Log::GetDroppedMessages() {
+  std::shared_ptr<spdlog::details::thread_pool> pool = spdlog::thread_pool();
+  return pool ? pool->overrun_counter() : 0;
+}
+}  // namespace Onyx
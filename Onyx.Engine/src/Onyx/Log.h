@@ -1,34 +1,123 @@
 #pragma once
 
 #include <spdlog/spdlog.h>
-//
-#include <spdlog/sinks/stdout_color_sinks.h>
 
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "Onyx/Core.h"
 
+// Severity levels for ONYX_LOG_LEVEL, matching spdlog's.
+#define ONYX_LOG_LEVEL_TRACE 0
+#define ONYX_LOG_LEVEL_DEBUG 1
+#define ONYX_LOG_LEVEL_INFO 2
+#define ONYX_LOG_LEVEL_WARN 3
+#define ONYX_LOG_LEVEL_ERROR 4
+#define ONYX_LOG_LEVEL_FATAL 5
+#define ONYX_LOG_LEVEL_OFF 6
+
+// Log macros below this level compile to nothing, arguments included.
+#ifndef ONYX_LOG_LEVEL
+#if defined(ONYX_DIST)
+#define ONYX_LOG_LEVEL ONYX_LOG_LEVEL_WARN
+#elif defined(ONYX_RELEASE)
+#define ONYX_LOG_LEVEL ONYX_LOG_LEVEL_INFO
+#else
+#define ONYX_LOG_LEVEL ONYX_LOG_LEVEL_TRACE
+#endif
+#endif
+
 namespace Onyx {
 extern std::shared_ptr<spdlog::logger> g_CoreLogger;
 
+enum class LogOverflowPolicy {
+  // The logging thread waits for room in the queue.
+  Block,
+  // The oldest queued message is dropped to make room.
+  DropOldest
+};
+
+struct LogSettings {
+  // Write messages on a background thread. Callers still format the message and copy it into a
+  // queue allocated up front; only the sinks' I/O leaves the calling thread. The binary log macros
+  // in Onyx/Debug/BinaryLog.h defer the formatting as well.
+  bool Async = true;
+  // Messages the queue holds before OverflowPolicy applies.
+  size_t QueueSize = 8192;
+  LogOverflowPolicy OverflowPolicy = LogOverflowPolicy::DropOldest;
+  // Messages below this level are dropped at run time. Messages below ONYX_LOG_LEVEL never make
+  // it into the build.
+  spdlog::level::level_enum Level = static_cast<spdlog::level::level_enum>(ONYX_LOG_LEVEL);
+  // File written alongside the terminal. Empty disables it. Once the file reaches RotateBytes it
+  // is rotated, keeping RotateFiles old ones; zero never rotates and truncates it on start.
+  std::string FilePath = "logs/Onyx.log";
+  size_t RotateBytes = 8 * 1024 * 1024;
+  size_t RotateFiles = 3;
+  // Recent messages kept in memory for the in-game console. Zero disables it.
+  size_t ConsoleLines = 1024;
+};
+
+struct LogLine {
+  spdlog::level::level_enum Level = spdlog::level::info;
+  std::string Text;
+};
+
 class ONYX_API Log {
  public:
-  static void Init();
+  static void Init(const LogSettings& settings = LogSettings());
+  // Writes out everything still queued and stops the logging thread.
+  static void Shutdown();
+  // Blocks until everything logged so far has been written.
+  static void Flush();
   static Ref<spdlog::logger>& GetLogger();
+
+  // Copies the lines kept for the console into out, oldest first, reusing its storage.
+  static void GetConsoleLines(std::vector<LogLine>& out);
+  static void ClearConsole();
+  // Messages dropped because the queue was full.
+  static size_t GetDroppedMessages();
 };
 }  // namespace Onyx
 
-#define OnyxFatal(msg, ...) ::Onyx::Log::GetLogger()->critical(msg, __VA_ARGS__)
-#define OnyxError(msg, ...) ::Onyx::Log::GetLogger()->error(msg, __VA_ARGS__)
-#define OnyxWarn(msg, ...) ::Onyx::Log::GetLogger()->warn(msg, __VA_ARGS__)
-#define OnyxInfo(msg, ...) ::Onyx::Log::GetLogger()->info(msg, __VA_ARGS__)
-#define OnyxDebug(msg, ...) ::Onyx::Log::GetLogger()->debug(msg, __VA_ARGS__)
-#define OnyxTrace(msg, ...) ::Onyx::Log::GetLogger()->trace(msg, __VA_ARGS__)
+#if ONYX_LOG_LEVEL <= ONYX_LOG_LEVEL_FATAL
+#define OnyxFatal(...) ::Onyx::Log::GetLogger()->critical(__VA_ARGS__)
+#else
+#define OnyxFatal(...) ((void)0)
+#endif
+#if ONYX_LOG_LEVEL <= ONYX_LOG_LEVEL_ERROR
+#define OnyxError(...) ::Onyx::Log::GetLogger()->error(__VA_ARGS__)
+#else
+#define OnyxError(...) ((void)0)
+#endif
+#if ONYX_LOG_LEVEL <= ONYX_LOG_LEVEL_WARN
+#define OnyxWarn(...) ::Onyx::Log::GetLogger()->warn(__VA_ARGS__)
+#else
+#define OnyxWarn(...) ((void)0)
+#endif
+#if ONYX_LOG_LEVEL <= ONYX_LOG_LEVEL_INFO
+#define OnyxInfo(...) ::Onyx::Log::GetLogger()->info(__VA_ARGS__)
+#else
+#define OnyxInfo(...) ((void)0)
+#endif
+#if ONYX_LOG_LEVEL <= ONYX_LOG_LEVEL_DEBUG
+#define OnyxDebug(...) ::Onyx::Log::GetLogger()->debug(__VA_ARGS__)
+#else
+#define OnyxDebug(...) ((void)0)
+#endif
+#if ONYX_LOG_LEVEL <= ONYX_LOG_LEVEL_TRACE
+#define OnyxTrace(...) ::Onyx::Log::GetLogger()->trace(__VA_ARGS__)
+#else
+#define OnyxTrace(...) ((void)0)
+#endif
 
+// The message is flushed before breaking, since the process may not survive the break.
 #define OnyxAssert(expr, ...)                                                           \
   {                                                                                     \
     if (!(expr)) {                                                                      \
       OnyxFatal("--- Assertion Failed ---\n  @{}:{}\n  {}", __FILE__, __LINE__, #expr); \
-      __debugbreak();                                                                   \
+      ::Onyx::Log::Flush();                                                             \
+      ONYX_DEBUGBREAK();                                                                \
     }                                                                                   \
-  }
\ No newline at end of file
+  }
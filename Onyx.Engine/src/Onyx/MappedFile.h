@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+// Read-only view of a whole file mapped into memory, so reading it costs no copies and pages are
+// only loaded as they are touched. Empty files can't be mapped and are reported as not open.
+class ONYX_API MappedFile final {
+ public:
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool IsOpen() const { return m_Data != nullptr; }
+  const unsigned char* GetData() const { return m_Data; }
+  size_t GetSize() const { return m_Size; }
+
+ private:
+  const unsigned char* m_Data = nullptr;
+  size_t m_Size = 0;
+#ifdef ONYX_PLATFORM_WINDOWS
+  void* m_File = nullptr;
+  void* m_Mapping = nullptr;
+#endif
+};
+}  // namespace Onyx
@@ -0,0 +1,37 @@
+#include "pch.h"
+
+#include "FrameAllocator.h"
+
+#include <array>
+
+namespace Onyx {
+struct FrameAllocatorData {
+  static constexpr size_t BlockSize = 1024 * 1024;
+
+  std::array<LinearArena, 2> Arenas{LinearArena(BlockSize), LinearArena(BlockSize)};
+  size_t Current = 0;
+  FrameAllocator::Statistics Stats;
+};
+
+static FrameAllocatorData s_Data;
+static thread_local LinearArena t_Scratch;
+
+void* FrameAllocator::Allocate(size_t size, size_t alignment) {
+  return GetArena().Allocate(size, alignment);
+}
+
+LinearArena& FrameAllocator::GetArena() { return s_Data.Arenas[s_Data.Current]; }
+
+void FrameAllocator::EndFrame() {
+  s_Data.Stats.UsedBytes = GetArena().GetUsedBytes();
+  s_Data.Current = 1 - s_Data.Current;
+  GetArena().Reset();
+  s_Data.Stats.Capacity = s_Data.Arenas[0].GetCapacity() + s_Data.Arenas[1].GetCapacity();
+}
+
+const FrameAllocator::Statistics& FrameAllocator::GetStats() { return s_Data.Stats; }
+
+ScratchScope::ScratchScope() : m_Arena(t_Scratch), m_Marker(t_Scratch.GetMarker()) {}
+
+ScratchScope::~ScratchScope() { m_Arena.Rewind(m_Marker); }
+}  // namespace Onyx
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "Onyx/Core.h"
+#include "Onyx/Memory/LinearArena.h"
+
+namespace Onyx {
+// Transient memory for the main thread. There are two arenas that swap at the end of every
+// frame, so memory stays valid for the rest of the frame it was allocated in and all of the next
+// one, long enough for a render thread one frame behind to read it.
+class ONYX_API FrameAllocator final {
+ public:
+  struct Statistics {
+    size_t UsedBytes = 0;  // In the frame before this one.
+    size_t Capacity = 0;
+  };
+
+  static void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  template <typename T>
+  static T* AllocateArray(size_t count) {
+    return GetArena().AllocateArray<T>(count);
+  }
+
+  template <typename T, typename... Args>
+  static T* New(Args&&... args) {
+    return GetArena().New<T>(std::forward<Args>(args)...);
+  }
+
+  // For containers: ArenaVector<int> values(FrameAllocator::GetAllocator<int>());
+  template <typename T>
+  static ArenaAllocator<T> GetAllocator() {
+    return ArenaAllocator<T>(GetArena());
+  }
+
+  static LinearArena& GetArena();
+  // Swaps the arenas and resets the one that becomes current. Called by the application.
+  static void EndFrame();
+  static const Statistics& GetStats();
+};
+
+// Rewinds the calling thread's scratch arena to where it was when the scope was opened, so
+// temporaries of any thread can be allocated without touching the heap once the arena has grown.
+// Scopes nest; memory from an inner scope must not outlive it.
+class ONYX_API ScratchScope final {
+ public:
+  ScratchScope();
+  ~ScratchScope();
+
+  ScratchScope(const ScratchScope&) = delete;
+  ScratchScope& operator=(const ScratchScope&) = delete;
+
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) {
+    return m_Arena.Allocate(size, alignment);
+  }
+
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    return m_Arena.AllocateArray<T>(count);
+  }
+
+  template <typename T>
+  ArenaAllocator<T> GetAllocator() {
+    return ArenaAllocator<T>(m_Arena);
+  }
+
+  LinearArena& GetArena() { return m_Arena; }
+
+ private:
+  LinearArena& m_Arena;
+  LinearArena::Marker m_Marker;
+};
+}  // namespace Onyx
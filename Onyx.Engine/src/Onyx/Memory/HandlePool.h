@@ -0,0 +1,159 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Log.h"
+
+namespace Onyx {
+// A 32-bit reference into a HandlePool<T>: a slot index and the generation of that slot when the
+// handle was made. Releasing an object bumps its slot's generation, so handles to it go stale
+// instead of dangling. A default-constructed handle is null.
+template <typename T>
+class Handle {
+ public:
+  static constexpr uint32_t IndexBits = 20;
+  static constexpr uint32_t GenerationBits = 32 - IndexBits;
+  static constexpr uint32_t MaxIndex = (1u << IndexBits) - 1;
+  static constexpr uint32_t MaxGeneration = (1u << GenerationBits) - 1;
+
+  Handle() = default;
+  Handle(uint32_t index, uint32_t generation) : m_Value((generation << IndexBits) | index) {}
+
+  // Only says the handle was made by a pool, HandlePool::IsAlive says whether it still refers to
+  // something.
+  bool IsValid() const { return m_Value != 0; }
+  uint32_t GetIndex() const { return m_Value & MaxIndex; }
+  uint32_t GetGeneration() const { return m_Value >> IndexBits; }
+  uint32_t GetValue() const { return m_Value; }
+
+  bool operator==(const Handle& other) const { return m_Value == other.m_Value; }
+  bool operator!=(const Handle& other) const { return m_Value != other.m_Value; }
+
+ private:
+  uint32_t m_Value = 0;
+};
+
+// Owns objects in one contiguous array and hands out generational handles to them, as a
+// lighter alternative to Ref<T> for resources with a single owner: no atomic reference counts, no
+// per-object heap allocations, and iteration over every object is a linear walk. Objects are
+// released explicitly; releasing moves the last object into the hole, so pointers from Get and
+// the iteration order only hold until the next Create or Release. A slot is reused up to
+// MaxGeneration times before an old handle to it can alias a new object. Not thread-safe.
+template <typename T>
+class HandlePool final {
+ public:
+  using HandleType = Handle<T>;
+
+  void Reserve(size_t count) {
+    m_Objects.reserve(count);
+    m_Owners.reserve(count);
+    m_Slots.reserve(count);
+  }
+
+  template <typename... Args>
+  HandleType Create(Args&&... args) {
+    uint32_t index;
+    if (m_FreeHead != NoSlot) {
+      index = m_FreeHead;
+      m_FreeHead = m_Slots[index].Dense;
+    } else {
+      OnyxAssert(m_Slots.size() <= HandleType::MaxIndex, "HandlePool is full!");
+      index = static_cast<uint32_t>(m_Slots.size());
+      m_Slots.push_back({NoSlot, 1});
+    }
+
+    Slot& slot = m_Slots[index];
+    slot.Dense = static_cast<uint32_t>(m_Objects.size());
+    m_Objects.emplace_back(std::forward<Args>(args)...);
+    m_Owners.push_back(index);
+    return HandleType(index, slot.Generation);
+  }
+
+  // Returns false if the handle was already stale.
+  bool Release(HandleType handle) {
+    if (!IsAlive(handle)) {
+      return false;
+    }
+
+    const uint32_t index = handle.GetIndex();
+    Slot& slot = m_Slots[index];
+    const uint32_t dense = slot.Dense;
+    const uint32_t last = static_cast<uint32_t>(m_Objects.size()) - 1;
+    if (dense != last) {
+      m_Objects[dense] = std::move(m_Objects[last]);
+      m_Owners[dense] = m_Owners[last];
+      m_Slots[m_Owners[dense]].Dense = dense;
+    }
+    m_Objects.pop_back();
+    m_Owners.pop_back();
+
+    // Generation 0 is never handed out, so null handles can't match a slot.
+    slot.Generation = slot.Generation == HandleType::MaxGeneration ? 1 : slot.Generation + 1;
+    slot.Dense = m_FreeHead;
+    m_FreeHead = index;
+    return true;
+  }
+
+  bool IsAlive(HandleType handle) const {
+    const uint32_t index = handle.GetIndex();
+    return index < m_Slots.size() && m_Slots[index].Generation == handle.GetGeneration() &&
+           handle.IsValid();
+  }
+
+  // Null for stale handles.
+  T* Get(HandleType handle) {
+    return IsAlive(handle) ? &m_Objects[m_Slots[handle.GetIndex()].Dense] : nullptr;
+  }
+  const T* Get(HandleType handle) const {
+    return IsAlive(handle) ? &m_Objects[m_Slots[handle.GetIndex()].Dense] : nullptr;
+  }
+
+  void Clear() {
+    while (!m_Objects.empty()) {
+      Release(GetHandle(m_Objects.size() - 1));
+    }
+  }
+
+  size_t Size() const { return m_Objects.size(); }
+  bool Empty() const { return m_Objects.empty(); }
+
+  // The handle of the object at position i of the iteration order.
+  HandleType GetHandle(size_t i) const {
+    const uint32_t index = m_Owners[i];
+    return HandleType(index, m_Slots[index].Generation);
+  }
+
+  T* begin() { return m_Objects.data(); }
+  T* end() { return m_Objects.data() + m_Objects.size(); }
+  const T* begin() const { return m_Objects.data(); }
+  const T* end() const { return m_Objects.data() + m_Objects.size(); }
+
+ private:
+  static constexpr uint32_t NoSlot = ~0u;
+
+  // While free, Dense links to the next free slot.
+  struct Slot {
+    uint32_t Dense;
+    uint32_t Generation;
+  };
+
+  std::vector<T> m_Objects;
+  std::vector<uint32_t> m_Owners;  // Slot of every object.
+  std::vector<Slot> m_Slots;
+  uint32_t m_FreeHead = NoSlot;
+};
+}  // namespace Onyx
+
+namespace std {
+template <typename T>
+struct hash<Onyx::Handle<T>> {
+  size_t operator()(const Onyx::Handle<T>& handle) const {
+    return std::hash<uint32_t>()(handle.GetValue());
+  }
+};
+}  // namespace std
@@ -0,0 +1,98 @@
+#include "pch.h"
+
+#include "LinearArena.h"
+
+#include <cstdint>
+
+namespace Onyx {
+LinearArena::LinearArena(size_t blockSize) : m_BlockSize(blockSize) {}
+
+LinearArena::~LinearArena() {
+  for (Block& block : m_Blocks) {
+    ::operator delete(block.Data);
+  }
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment) {
+  OnyxAssert((alignment & (alignment - 1)) == 0, "Arena alignment must be a power of two!");
+
+  // Allocations never span blocks, move on to the next one that has room.
+  while (m_CurrentBlock < m_Blocks.size()) {
+    Block& block = m_Blocks[m_CurrentBlock];
+    const auto base = reinterpret_cast<uintptr_t>(block.Data);
+    const size_t offset = ((base + block.Used + alignment - 1) & ~(alignment - 1)) - base;
+    if (offset <= block.Size && block.Size - offset >= size) {
+      block.Used = offset + size;
+      return block.Data + offset;
+    }
+    if (m_CurrentBlock + 1 == m_Blocks.size()) {
+      break;
+    }
+    m_CurrentBlock++;
+  }
+
+  AddBlock(size + alignment);
+  Block& block = m_Blocks[m_CurrentBlock];
+  const auto base = reinterpret_cast<uintptr_t>(block.Data);
+  const size_t offset = ((base + alignment - 1) & ~(alignment - 1)) - base;
+  block.Used = offset + size;
+  return block.Data + offset;
+}
+
+void LinearArena::Reset() {
+  if (m_Blocks.size() > 1) {
+    const size_t capacity = GetCapacity();
+    for (Block& block : m_Blocks) {
+      ::operator delete(block.Data);
+    }
+    m_Blocks.clear();
+    m_CurrentBlock = 0;
+    AddBlock(capacity);
+  }
+
+  for (Block& block : m_Blocks) {
+    block.Used = 0;
+  }
+  m_CurrentBlock = 0;
+}
+
+LinearArena::Marker LinearArena::GetMarker() const {
+  return {m_CurrentBlock, m_Blocks.empty() ? 0 : m_Blocks[m_CurrentBlock].Used};
+}
+
+void LinearArena::Rewind(const Marker& marker) {
+  if (m_Blocks.empty() || marker.Block > m_CurrentBlock) {
+    return;
+  }
+
+  for (size_t i = marker.Block + 1; i <= m_CurrentBlock; ++i) {
+    m_Blocks[i].Used = 0;
+  }
+  m_CurrentBlock = marker.Block;
+  m_Blocks[m_CurrentBlock].Used = marker.Used;
+}
+
+size_t LinearArena::GetUsedBytes() const {
+  size_t used = 0;
+  for (const Block& block : m_Blocks) {
+    used += block.Used;
+  }
+  return used;
+}
+
+size_t LinearArena::GetCapacity() const {
+  size_t capacity = 0;
+  for (const Block& block : m_Blocks) {
+    capacity += block.Size;
+  }
+  return capacity;
+}
+
+void LinearArena::AddBlock(size_t minimumSize) {
+  const size_t size = std::max(minimumSize, m_BlockSize);
+  // Plain operator new already aligns for any fundamental type.
+  auto* data = static_cast<unsigned char*>(::operator new(size));
+  m_Blocks.push_back({data, size, 0});
+  m_CurrentBlock = m_Blocks.size() - 1;
+}
+}  // namespace Onyx
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+// Bump allocator over memory blocks that are kept between resets. Nothing is freed individually;
+// the whole arena is reset, or rewound to a marker, at once. When a reset finds that more than one
+// block was needed, they are merged into one, so a steady workload soon stops allocating.
+// Not thread-safe.
+class ONYX_API LinearArena final {
+ public:
+  struct Marker {
+    size_t Block = 0;
+    size_t Used = 0;
+  };
+
+  explicit LinearArena(size_t blockSize = 64 * 1024);
+  ~LinearArena();
+
+  LinearArena(const LinearArena&) = delete;
+  LinearArena& operator=(const LinearArena&) = delete;
+
+  void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+  template <typename T>
+  T* AllocateArray(size_t count) {
+    return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  // Destructors are never run, so only types that don't need one are allowed.
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    static_assert(std::is_trivially_destructible_v<T>, "Arena objects are never destroyed");
+    return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+  }
+
+  void Reset();
+  Marker GetMarker() const;
+  // Frees everything allocated since the marker was taken.
+  void Rewind(const Marker& marker);
+
+  size_t GetUsedBytes() const;
+  size_t GetCapacity() const;
+
+ private:
+  struct Block {
+    unsigned char* Data;
+    size_t Size;
+    size_t Used;
+  };
+
+  void AddBlock(size_t minimumSize);
+
+  std::vector<Block> m_Blocks;
+  size_t m_CurrentBlock = 0;
+  size_t m_BlockSize;
+};
+
+// Lets standard containers allocate from an arena. Deallocation does nothing, so containers that
+// grow leave their old storage behind until the arena is reset; reserve up front where possible.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  ArenaAllocator(LinearArena& arena) noexcept : m_Arena(&arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_Arena(other.GetArena()) {}
+
+  T* allocate(size_t count) { return m_Arena->AllocateArray<T>(count); }
+  void deallocate(T*, size_t) noexcept {}
+
+  LinearArena* GetArena() const { return m_Arena; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return m_Arena == other.GetArena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return m_Arena != other.GetArena();
+  }
+
+ private:
+  LinearArena* m_Arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+}  // namespace Onyx
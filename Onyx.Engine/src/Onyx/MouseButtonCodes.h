@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 namespace Onyx {
 enum class MouseButton {
   B1 = 0,
@@ -15,4 +17,6 @@ enum class MouseButton {
   RIGHT = B2,
   MIDDLE = B3
 };
+
+constexpr size_t MouseButtonCount = static_cast<size_t>(MouseButton::LAST) + 1;
 }
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "pch.h"
+
+#include "Buffer.h"
+
+#include "Onyx/Renderer/RendererAPI.h"
+#include "Platform/OpenGL/OpenGLBuffer.h"
+
+namespace Onyx {
+Ref<VertexBuffer> VertexBuffer::Create(uint32_t size) {
+  switch (RendererAPI::GetAPI()) {
+    case RendererAPI::API::OpenGL:
+      return CreateRef<OpenGLVertexBuffer>(size);
+    case RendererAPI::API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+
+Ref<VertexBuffer> VertexBuffer::Create(const float* vertices, uint32_t size) {
+  switch (RendererAPI::GetAPI()) {
+    case RendererAPI::API::OpenGL:
+      return CreateRef<OpenGLVertexBuffer>(vertices, size);
+    case RendererAPI::API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+
+Ref<IndexBuffer> IndexBuffer::Create(const uint32_t* indices, uint32_t count) {
+  switch (RendererAPI::GetAPI()) {
+    case RendererAPI::API::OpenGL:
+      return CreateRef<OpenGLIndexBuffer>(indices, count);
+    case RendererAPI::API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+}  // namespace Onyx
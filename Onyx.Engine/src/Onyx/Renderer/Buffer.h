@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Log.h"
+
+namespace Onyx {
+enum class ShaderDataType {
+  None,
+  Float,
+  Float2,
+  Float3,
+  Float4,
+  Mat3,
+  Mat4,
+  Int,
+  Int2,
+  Int3,
+  Int4,
+  Bool
+};
+
+inline uint32_t ShaderDataTypeSize(ShaderDataType type) {
+  switch (type) {
+    case ShaderDataType::Float:
+      return 4;
+    case ShaderDataType::Float2:
+      return 4 * 2;
+    case ShaderDataType::Float3:
+      return 4 * 3;
+    case ShaderDataType::Float4:
+      return 4 * 4;
+    case ShaderDataType::Mat3:
+      return 4 * 3 * 3;
+    case ShaderDataType::Mat4:
+      return 4 * 4 * 4;
+    case ShaderDataType::Int:
+      return 4;
+    case ShaderDataType::Int2:
+      return 4 * 2;
+    case ShaderDataType::Int3:
+      return 4 * 3;
+    case ShaderDataType::Int4:
+      return 4 * 4;
+    case ShaderDataType::Bool:
+      return 1;
+    case ShaderDataType::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown ShaderDataType!");
+  return 0;
+}
+
+struct BufferElement {
+  std::string Name;
+  ShaderDataType Type = ShaderDataType::None;
+  uint32_t Size = 0;
+  uint32_t Offset = 0;
+  bool Normalized = false;
+
+  BufferElement() = default;
+  BufferElement(ShaderDataType type, const std::string& name, bool normalized = false)
+      : Name(name), Type(type), Size(ShaderDataTypeSize(type)), Normalized(normalized) {}
+
+  uint32_t GetComponentCount() const {
+    switch (Type) {
+      case ShaderDataType::Float:
+        return 1;
+      case ShaderDataType::Float2:
+        return 2;
+      case ShaderDataType::Float3:
+        return 3;
+      case ShaderDataType::Float4:
+        return 4;
+      case ShaderDataType::Mat3:
+        return 3;  // Per column.
+      case ShaderDataType::Mat4:
+        return 4;  // Per column.
+      case ShaderDataType::Int:
+        return 1;
+      case ShaderDataType::Int2:
+        return 2;
+      case ShaderDataType::Int3:
+        return 3;
+      case ShaderDataType::Int4:
+        return 4;
+      case ShaderDataType::Bool:
+        return 1;
+      case ShaderDataType::None:
+        break;
+    }
+
+    OnyxAssert(false, "Unknown ShaderDataType!");
+    return 0;
+  }
+};
+
+// Describes how the vertices of a buffer are laid out, in the order given.
+class BufferLayout {
+ public:
+  BufferLayout() = default;
+  BufferLayout(std::initializer_list<BufferElement> elements) : m_Elements(elements) {
+    uint32_t offset = 0;
+    for (BufferElement& element : m_Elements) {
+      element.Offset = offset;
+      offset += element.Size;
+    }
+    m_Stride = offset;
+  }
+
+  uint32_t GetStride() const { return m_Stride; }
+  const std::vector<BufferElement>& GetElements() const { return m_Elements; }
+
+  std::vector<BufferElement>::const_iterator begin() const { return m_Elements.begin(); }
+  std::vector<BufferElement>::const_iterator end() const { return m_Elements.end(); }
+
+ private:
+  std::vector<BufferElement> m_Elements;
+  uint32_t m_Stride = 0;
+};
+
+// GPU buffers. Like every renderer object, these are used from the main thread only; any work on
+// the graphics API is submitted to the Renderer, and the data passed in is copied, so callers may
+// free it right away.
+class ONYX_API VertexBuffer {
+ public:
+  virtual ~VertexBuffer() = default;
+
+  virtual void Bind() const = 0;
+  virtual void Unbind() const = 0;
+
+  virtual void SetData(const void* data, uint32_t size) = 0;
+  // For buffers created with only a size: writes data into the next free region of the buffer,
+  // used as a ring, and returns the byte offset it lands at, aligned to the layout's stride. The
+  // data is not copied, it must stay valid until the frame has executed (see Renderer::Allocate).
+  virtual uint32_t Stream(const void* data, uint32_t size) = 0;
+
+  virtual const BufferLayout& GetLayout() const = 0;
+  virtual void SetLayout(const BufferLayout& layout) = 0;
+
+  // A dynamic buffer of the given size, to be filled with SetData or Stream.
+  static Ref<VertexBuffer> Create(uint32_t size);
+  static Ref<VertexBuffer> Create(const float* vertices, uint32_t size);
+};
+
+class ONYX_API IndexBuffer {
+ public:
+  virtual ~IndexBuffer() = default;
+
+  virtual void Bind() const = 0;
+  virtual void Unbind() const = 0;
+
+  virtual uint32_t GetCount() const = 0;
+
+  static Ref<IndexBuffer> Create(const uint32_t* indices, uint32_t count);
+};
+}  // namespace Onyx
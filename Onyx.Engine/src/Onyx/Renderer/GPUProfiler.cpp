@@ -0,0 +1,227 @@
+#include "pch.h"
+
+#include "GPUProfiler.h"
+
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+
+#include "Onyx/Debug/Profiler.h"
+#include "Onyx/Memory/FrameAllocator.h"
+#include "Onyx/Renderer/Renderer.h"
+#include "Onyx/Renderer/TimerQueryPool.h"
+
+namespace Onyx {
+// Passes timed during one frame. Pass i uses the start and end queries 2i and 2i + 1 of the
+// frame's share of the pool.
+struct GPUFrame {
+  uint32_t PassCount = 0;
+  std::array<const char*, GPUProfiler::MaxPassesPerFrame> Names;
+};
+
+struct GPUPassHistory {
+  const char* Name = nullptr;
+  std::array<float, GPUProfiler::HistorySize> Samples;
+  uint32_t Count = 0;
+  uint32_t Next = 0;
+};
+
+struct GPUProfilerData {
+  static constexpr uint32_t Skipped = ~0u;
+
+  // Render thread only.
+  Scope<TimerQueryPool> Queries;
+  std::array<GPUFrame, GPUProfiler::FrameLatency> Frames;
+  uint32_t CurrentFrame = 0;
+  std::vector<uint32_t> OpenPasses;  // Skipped for passes past MaxPassesPerFrame.
+#if ONYX_PROFILE
+  ProfileThreadBuffer* Track = nullptr;
+  // Profiler clock minus GPU clock.
+  int64_t ClockOffset = 0;
+#endif
+
+  // Shared with the main thread.
+  std::mutex Mutex;
+  std::vector<GPUPassHistory> History;
+  uint64_t DroppedFrames = 0;
+};
+
+static Scope<GPUProfilerData> s_Data;
+
+static uint32_t GetQueryIndex(uint32_t frame, uint32_t pass, uint32_t end) {
+  return (frame * GPUProfiler::MaxPassesPerFrame + pass) * 2 + end;
+}
+
+static bool IsTiming() { return s_Data->Queries && s_Data->Queries->IsSupported(); }
+
+#if ONYX_PROFILE
+static void Calibrate() {
+  s_Data->ClockOffset = static_cast<int64_t>(Profiler::Now()) -
+                        static_cast<int64_t>(s_Data->Queries->GetCurrentTimestamp());
+}
+#endif
+
+// Reads back a frame from FrameLatency frames ago, unless it is somehow still in flight.
+static void ResolveFrame(uint32_t index) {
+  const GPUFrame& frame = s_Data->Frames[index];
+  const TimerQueryPool& queries = *s_Data->Queries;
+  for (uint32_t pass = 0; pass < frame.PassCount; ++pass) {
+    if (!queries.IsAvailable(GetQueryIndex(index, pass, 0)) ||
+        !queries.IsAvailable(GetQueryIndex(index, pass, 1))) {
+      std::lock_guard<std::mutex> lock(s_Data->Mutex);
+      s_Data->DroppedFrames++;
+      return;
+    }
+  }
+
+  for (uint32_t pass = 0; pass < frame.PassCount; ++pass) {
+    const uint64_t start = queries.GetTimestamp(GetQueryIndex(index, pass, 0));
+    const uint64_t end = queries.GetTimestamp(GetQueryIndex(index, pass, 1));
+    uint64_t startNs = 0;
+#if ONYX_PROFILE
+    startNs = static_cast<uint64_t>(static_cast<int64_t>(start) + s_Data->ClockOffset);
+#endif
+    GPUProfiler::AddSample(frame.Names[pass], startNs, end > start ? end - start : 0);
+  }
+}
+
+void GPUProfiler::Init() {
+  s_Data = CreateScope<GPUProfilerData>();
+#if ONYX_PROFILE
+  s_Data->Track = Profiler::CreateTrack("GPU");
+#endif
+
+  Renderer::Submit([]() {
+    s_Data->Queries = TimerQueryPool::Create(FrameLatency * MaxPassesPerFrame * 2);
+#if ONYX_PROFILE
+    if (IsTiming()) {
+      Calibrate();
+    }
+#endif
+  });
+}
+
+void GPUProfiler::Shutdown() {
+  // The queries belong to the context, so they go on the thread that owns it.
+  Renderer::Submit([]() { s_Data->Queries.reset(); });
+  Renderer::Flush();
+  s_Data.reset();
+}
+
+void GPUProfiler::BeginPass(const char* name) {
+  Renderer::Submit([name]() {
+    if (!IsTiming()) {
+      return;
+    }
+
+    GPUFrame& frame = s_Data->Frames[s_Data->CurrentFrame];
+    if (frame.PassCount == MaxPassesPerFrame) {
+      s_Data->OpenPasses.push_back(GPUProfilerData::Skipped);
+      return;
+    }
+
+    const uint32_t pass = frame.PassCount++;
+    frame.Names[pass] = name;
+    s_Data->Queries->WriteTimestamp(GetQueryIndex(s_Data->CurrentFrame, pass, 0));
+    s_Data->OpenPasses.push_back(pass);
+  });
+}
+
+void GPUProfiler::EndPass() {
+  Renderer::Submit([]() {
+    if (!IsTiming()) {
+      return;
+    }
+
+    OnyxAssert(!s_Data->OpenPasses.empty(), "GPUProfiler::EndPass without a matching BeginPass!");
+    const uint32_t pass = s_Data->OpenPasses.back();
+    s_Data->OpenPasses.pop_back();
+    if (pass != GPUProfilerData::Skipped) {
+      s_Data->Queries->WriteTimestamp(GetQueryIndex(s_Data->CurrentFrame, pass, 1));
+    }
+  });
+}
+
+void GPUProfiler::EndFrame() {
+  Renderer::Submit([]() {
+    if (!IsTiming()) {
+      return;
+    }
+
+    OnyxAssert(s_Data->OpenPasses.empty(), "GPU pass still open at the end of the frame!");
+#if ONYX_PROFILE
+    // The two clocks drift apart, so keep them lined up while anyone is looking.
+    if (Profiler::IsActive()) {
+      Calibrate();
+    }
+#endif
+
+    // The frame about to be recorded into is the oldest one in the ring.
+    s_Data->CurrentFrame = (s_Data->CurrentFrame + 1) % FrameLatency;
+    GPUFrame& frame = s_Data->Frames[s_Data->CurrentFrame];
+    if (frame.PassCount > 0) {
+      ResolveFrame(s_Data->CurrentFrame);
+      frame.PassCount = 0;
+    }
+  });
+}
+
+void GPUProfiler::AddSample(const char* name, uint64_t startNs, uint64_t durationNs) {
+  {
+    std::lock_guard<std::mutex> lock(s_Data->Mutex);
+    auto it = std::find_if(
+        s_Data->History.begin(), s_Data->History.end(),
+        [name](const GPUPassHistory& history) { return std::strcmp(history.Name, name) == 0; });
+    if (it == s_Data->History.end()) {
+      it = s_Data->History.emplace(s_Data->History.end());
+      it->Name = name;
+    }
+
+    it->Samples[it->Next] = static_cast<float>(durationNs) / 1.0e6f;
+    it->Next = (it->Next + 1) % HistorySize;
+    it->Count = std::min(it->Count + 1, HistorySize);
+  }
+
+#if ONYX_PROFILE
+  if (Profiler::IsActive() && startNs > 0) {
+    Profiler::Record(s_Data->Track, name, startNs, durationNs);
+  }
+#endif
+}
+
+ArenaVector<GPUPassStats> GPUProfiler::GetPassStats() {
+  ArenaVector<GPUPassStats> stats(FrameAllocator::GetAllocator<GPUPassStats>());
+  ScratchScope scratch;
+  float* const samples = scratch.AllocateArray<float>(HistorySize);
+
+  std::lock_guard<std::mutex> lock(s_Data->Mutex);
+  stats.reserve(s_Data->History.size());
+  for (const GPUPassHistory& history : s_Data->History) {
+    GPUPassStats& pass = stats.emplace_back();
+    pass.Name = history.Name;
+    pass.SampleCount = history.Count;
+    pass.LastMs = history.Samples[(history.Next + HistorySize - 1) % HistorySize];
+
+    const uint32_t count = history.Count;
+    std::copy(history.Samples.begin(), history.Samples.begin() + count, samples);
+    float total = 0.0f;
+    pass.MinMs = samples[0];
+    for (uint32_t i = 0; i < count; ++i) {
+      pass.MinMs = std::min(pass.MinMs, samples[i]);
+      total += samples[i];
+    }
+    pass.AvgMs = total / static_cast<float>(count);
+
+    const auto rank = static_cast<size_t>(std::ceil(0.99f * count)) - 1;
+    std::nth_element(samples, samples + rank, samples + count);
+    pass.P99Ms = samples[rank];
+  }
+  return stats;
+}
+
+uint64_t GPUProfiler::GetDroppedFrames() {
+  std::lock_guard<std::mutex> lock(s_Data->Mutex);
+  return s_Data->DroppedFrames;
+}
+}  // namespace Onyx
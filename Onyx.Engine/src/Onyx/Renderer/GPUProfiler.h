@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Onyx/Core.h"
+#include "Onyx/Memory/LinearArena.h"
+
+namespace Onyx {
+struct GPUPassStats {
+  const char* Name = nullptr;
+  float LastMs = 0.0f;
+  float MinMs = 0.0f;
+  float AvgMs = 0.0f;
+  float P99Ms = 0.0f;
+  // Samples the other figures are taken over, at most GPUProfiler::HistorySize.
+  uint32_t SampleCount = 0;
+};
+
+// Measures how long passes take on the GPU. Each pass is bracketed by timestamp queries from a
+// ring that spans several frames, and a frame's results are only read once the ring comes back
+// around to it, so reading them never waits on the GPU. Results that still aren't ready by then
+// are dropped. While a profiling session runs, passes are also exported on a "GPU" track.
+class ONYX_API GPUProfiler final {
+ public:
+  static constexpr uint32_t MaxPassesPerFrame = 32;
+  // Frames between timing a pass and reading its result.
+  static constexpr uint32_t FrameLatency = 4;
+  static constexpr uint32_t HistorySize = 240;
+
+  static void Init();
+  static void Shutdown();
+
+  // Bracket the work submitted between them. Passes may nest; the name must have static storage
+  // duration. Main thread only, like Renderer::Submit.
+  static void BeginPass(const char* name);
+  static void EndPass();
+  // Called by the renderer at the end of every frame.
+  static void EndFrame();
+
+  // For GPU work timed outside of passes, e.g. on another context. startNs is on the profiler's
+  // clock and only used for export. Safe to call from whichever thread runs the graphics API.
+  static void AddSample(const char* name, uint64_t startNs, uint64_t durationNs);
+
+  // Figures over the last HistorySize samples of every pass, in the order they were first seen.
+  // Allocated from the FrameAllocator, so only for the main thread and only until the next frame.
+  static ArenaVector<GPUPassStats> GetPassStats();
+  // Frames whose results weren't ready in time.
+  static uint64_t GetDroppedFrames();
+};
+
+class GPUPassScope final {
+ public:
+  explicit GPUPassScope(const char* name) { GPUProfiler::BeginPass(name); }
+  ~GPUPassScope() { GPUProfiler::EndPass(); }
+
+  GPUPassScope(const GPUPassScope&) = delete;
+  GPUPassScope& operator=(const GPUPassScope&) = delete;
+};
+}  // namespace Onyx
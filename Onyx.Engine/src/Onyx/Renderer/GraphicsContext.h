@@ -3,8 +3,14 @@
 namespace Onyx {
 class GraphicsContext {
  public:
+  virtual ~GraphicsContext() = default;
+
   virtual void Init() = 0;
   virtual void Shutdown() = 0;
   virtual void SwapBuffers() = 0;
+
+  // Bind the context to, or release it from, the calling thread.
+  virtual void MakeCurrent() = 0;
+  virtual void ReleaseCurrent() = 0;
 };
 }  // namespace Onyx
\ No newline at end of file
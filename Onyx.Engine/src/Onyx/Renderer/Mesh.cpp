@@ -0,0 +1,22 @@
+#include "pch.h"
+
+#include "Mesh.h"
+
+#include "Onyx/Renderer/Buffer.h"
+
+namespace Onyx {
+Mesh::Mesh(const MeshData& data) : m_IndexCount(static_cast<uint32_t>(data.Indices.size())) {
+  m_VertexArray = VertexArray::Create();
+
+  Ref<VertexBuffer> vertexBuffer =
+      VertexBuffer::Create(reinterpret_cast<const float*>(data.Vertices.data()),
+                           static_cast<uint32_t>(data.Vertices.size() * sizeof(MeshVertex)));
+  vertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
+                           {ShaderDataType::Float3, "a_Normal"},
+                           {ShaderDataType::Float2, "a_TexCoord"}});
+  m_VertexArray->AddVertexBuffer(vertexBuffer);
+  m_VertexArray->SetIndexBuffer(IndexBuffer::Create(data.Indices.data(), m_IndexCount));
+}
+
+Ref<Mesh> Mesh::Create(const MeshData& data) { return CreateRef<Mesh>(data); }
+}  // namespace Onyx
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Renderer/VertexArray.h"
+
+namespace Onyx {
+struct MeshVertex {
+  glm::vec3 Position;
+  glm::vec3 Normal;
+  glm::vec2 TexCoord;
+};
+
+// Indexed triangles as decoded from a file, before they are uploaded.
+struct MeshData {
+  std::vector<MeshVertex> Vertices;
+  std::vector<uint32_t> Indices;
+
+  uint64_t GetSize() const {
+    return Vertices.size() * sizeof(MeshVertex) + Indices.size() * sizeof(uint32_t);
+  }
+};
+
+// Static triangle mesh on the GPU, laid out as a_Position, a_Normal and a_TexCoord.
+class ONYX_API Mesh final {
+ public:
+  explicit Mesh(const MeshData& data);
+
+  const Ref<VertexArray>& GetVertexArray() const { return m_VertexArray; }
+  uint32_t GetIndexCount() const { return m_IndexCount; }
+
+  static Ref<Mesh> Create(const MeshData& data);
+
+ private:
+  Ref<VertexArray> m_VertexArray;
+  uint32_t m_IndexCount = 0;
+};
+}  // namespace Onyx
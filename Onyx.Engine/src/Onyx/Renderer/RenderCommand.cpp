@@ -0,0 +1,7 @@
+#include "pch.h"
+
+#include "RenderCommand.h"
+
+namespace Onyx {
+Scope<RendererAPI> RenderCommand::s_RendererAPI = RendererAPI::Create();
+}  // namespace Onyx
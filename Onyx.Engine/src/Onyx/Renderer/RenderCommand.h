@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Onyx/Core.h"
+#include "Onyx/Renderer/RendererAPI.h"
+
+namespace Onyx {
+// Entry point for all drawing, forwarding to the active RendererAPI.
+class ONYX_API RenderCommand final {
+ public:
+  static void Init() { s_RendererAPI->Init(); }
+
+  static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    s_RendererAPI->SetViewport(x, y, width, height);
+  }
+
+  static void SetClearColor(const glm::vec4& color) { s_RendererAPI->SetClearColor(color); }
+
+  static void Clear() { s_RendererAPI->Clear(); }
+
+  static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0,
+                          uint32_t baseVertex = 0) {
+    s_RendererAPI->DrawIndexed(vertexArray, indexCount, baseVertex);
+  }
+
+  static const RendererCapabilities& GetCapabilities() {
+    return s_RendererAPI->GetCapabilities();
+  }
+
+ private:
+  static Scope<RendererAPI> s_RendererAPI;
+};
+}  // namespace Onyx
@@ -0,0 +1,54 @@
+#include "pch.h"
+
+#include "RenderCommandQueue.h"
+
+namespace Onyx {
+RenderCommandQueue::~RenderCommandQueue() {
+  OnyxAssert(m_Commands.empty(), "Render command queue destroyed with pending commands!");
+  for (Block& block : m_Blocks) {
+    ::operator delete(block.Data, std::align_val_t(Alignment));
+  }
+}
+
+void* RenderCommandQueue::Allocate(size_t size) { return Reserve(size); }
+
+void RenderCommandQueue::Execute() {
+  for (const Command& command : m_Commands) {
+    command.Fn(command.Data);
+  }
+  m_Commands.clear();
+
+  for (Block& block : m_Blocks) {
+    block.Used = 0;
+  }
+  m_CurrentBlock = 0;
+}
+
+size_t RenderCommandQueue::GetUsedBytes() const {
+  size_t used = 0;
+  for (const Block& block : m_Blocks) {
+    used += block.Used;
+  }
+  return used;
+}
+
+void* RenderCommandQueue::Reserve(size_t size) {
+  size = (size + Alignment - 1) & ~(Alignment - 1);
+
+  // Commands never span blocks, move on to the next one that has room.
+  while (m_CurrentBlock < m_Blocks.size()) {
+    Block& block = m_Blocks[m_CurrentBlock];
+    if (block.Size - block.Used >= size) {
+      void* data = block.Data + block.Used;
+      block.Used += size;
+      return data;
+    }
+    m_CurrentBlock++;
+  }
+
+  const size_t blockSize = std::max(size, BlockSize);
+  auto* data = static_cast<unsigned char*>(::operator new(blockSize, std::align_val_t(Alignment)));
+  m_Blocks.push_back({data, blockSize, size});
+  return data;
+}
+}  // namespace Onyx
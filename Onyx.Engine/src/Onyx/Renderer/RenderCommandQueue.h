@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+// Records callables into linear memory blocks to be executed later, in submission order, possibly
+// on another thread. Memory is kept between frames, so a steady-state frame does not allocate.
+class ONYX_API RenderCommandQueue final {
+ public:
+  RenderCommandQueue() = default;
+  ~RenderCommandQueue();
+
+  RenderCommandQueue(const RenderCommandQueue&) = delete;
+  RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+  template <typename F>
+  void Submit(F&& fn);
+
+  // Raw memory that stays valid until the queue has been executed, for data a command refers to.
+  void* Allocate(size_t size);
+
+  // Runs and destroys every recorded command, then recycles the queue's memory.
+  void Execute();
+
+  uint32_t GetCommandCount() const { return static_cast<uint32_t>(m_Commands.size()); }
+  size_t GetUsedBytes() const;
+
+ private:
+  using CommandFn = void (*)(void* data);
+
+  struct Command {
+    CommandFn Fn;
+    void* Data;
+  };
+
+  struct Block {
+    unsigned char* Data;
+    size_t Size;
+    size_t Used;
+  };
+
+  static constexpr size_t BlockSize = 64 * 1024;
+  static constexpr size_t Alignment = alignof(std::max_align_t);
+
+  void* Reserve(size_t size);
+
+  std::vector<Command> m_Commands;
+  std::vector<Block> m_Blocks;
+  size_t m_CurrentBlock = 0;
+};
+
+template <typename F>
+void RenderCommandQueue::Submit(F&& fn) {
+  using Callable = std::decay_t<F>;
+  static_assert(alignof(Callable) <= Alignment, "Render command is over-aligned");
+
+  void* data = Reserve(sizeof(Callable));
+  new (data) Callable(std::forward<F>(fn));
+  m_Commands.push_back({[](void* data) {
+                          Callable* callable = std::launder(static_cast<Callable*>(data));
+                          (*callable)();
+                          callable->~Callable();
+                        },
+                        data});
+}
+}  // namespace Onyx
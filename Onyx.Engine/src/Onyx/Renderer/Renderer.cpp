@@ -0,0 +1,183 @@
+#include "pch.h"
+
+#include "Renderer.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Onyx/Debug/MemoryTracker.h"
+#include "Onyx/Debug/Profiler.h"
+#include "Onyx/Renderer/GPUProfiler.h"
+#include "Onyx/Renderer/RenderCommand.h"
+
+namespace Onyx {
+using RenderClock = std::chrono::steady_clock;
+
+struct RendererData {
+  GraphicsContext* Context = nullptr;
+  bool Threaded = false;
+  unsigned int FramesInFlight = 1;
+  RendererStats Stats;
+  ShaderLibrary Shaders;
+
+  // Backs Allocate() when commands run immediately.
+  RenderCommandQueue Scratch;
+
+  // One queue per frame in flight plus the one being recorded. Queue i % count holds frame i.
+  std::vector<Scope<RenderCommandQueue>> Queues;
+  RenderCommandQueue* Recording = nullptr;
+  std::thread Thread;
+  std::mutex Mutex;
+  std::condition_variable FrameSubmitted;
+  std::condition_variable FrameCompleted;
+  uint64_t Submitted = 0;
+  uint64_t Completed = 0;
+  float LastExecuteMs = 0.0f;
+  bool Running = false;
+};
+
+static Scope<RendererData> s_Data;
+
+static void RenderThreadMain() {
+  ONYX_PROFILE_THREAD("Render");
+  ONYX_MEMORY_THREAD_TAG(Renderer);
+  s_Data->Context->MakeCurrent();
+
+  std::unique_lock<std::mutex> lock(s_Data->Mutex);
+  while (true) {
+    s_Data->FrameSubmitted.wait(
+        lock, []() { return s_Data->Completed < s_Data->Submitted || !s_Data->Running; });
+    if (s_Data->Completed == s_Data->Submitted) {
+      break;
+    }
+
+    RenderCommandQueue& queue = *s_Data->Queues[s_Data->Completed % s_Data->Queues.size()];
+    lock.unlock();
+
+    const RenderClock::time_point start = RenderClock::now();
+    {
+      ONYX_PROFILE_SCOPE("Renderer::Execute");
+      queue.Execute();
+    }
+    const float executeMs =
+        std::chrono::duration<float, std::milli>(RenderClock::now() - start).count();
+
+    lock.lock();
+    s_Data->Completed++;
+    s_Data->LastExecuteMs = executeMs;
+    s_Data->FrameCompleted.notify_all();
+  }
+  lock.unlock();
+
+  s_Data->Context->ReleaseCurrent();
+}
+
+// Hands the recorded queue to the render thread and waits until no more than maxPending frames
+// are left unfinished, which guarantees the next queue to record into is free.
+static void Kick(uint64_t maxPending) {
+  ONYX_PROFILE_FUNCTION();
+
+  RendererStats& stats = s_Data->Stats;
+  stats.CommandCount = s_Data->Recording->GetCommandCount();
+  stats.CommandBytes = s_Data->Recording->GetUsedBytes();
+
+  const RenderClock::time_point start = RenderClock::now();
+  {
+    std::unique_lock<std::mutex> lock(s_Data->Mutex);
+    s_Data->Submitted++;
+    s_Data->FrameSubmitted.notify_one();
+    s_Data->FrameCompleted.wait(
+        lock, [maxPending]() { return s_Data->Submitted - s_Data->Completed <= maxPending; });
+
+    s_Data->Recording = s_Data->Queues[s_Data->Submitted % s_Data->Queues.size()].get();
+    stats.ExecuteMs = s_Data->LastExecuteMs;
+  }
+  stats.WaitMs = std::chrono::duration<float, std::milli>(RenderClock::now() - start).count();
+}
+
+void Renderer::Init(GraphicsContext* context, bool threaded, unsigned int framesInFlight) {
+  OnyxAssert(!s_Data, "Renderer initialized more than once!");
+
+  s_Data = CreateScope<RendererData>();
+  s_Data->Context = context;
+  s_Data->Threaded = threaded;
+  s_Data->FramesInFlight = std::max(framesInFlight, 1u);
+  if (threaded) {
+    OnyxInfo("Starting render thread with {} frame(s) in flight", s_Data->FramesInFlight);
+    for (unsigned int i = 0; i <= s_Data->FramesInFlight; ++i) {
+      s_Data->Queues.emplace_back(CreateScope<RenderCommandQueue>());
+    }
+    s_Data->Recording = s_Data->Queues[0].get();
+    s_Data->Running = true;
+
+    // A context can only be current on one thread at a time.
+    context->ReleaseCurrent();
+    s_Data->Thread = std::thread(RenderThreadMain);
+  }
+
+  // Wait for the backend to report its capabilities before anything is created.
+  RenderCommand::Init();
+  GPUProfiler::Init();
+  Flush();
+}
+
+void Renderer::Shutdown() {
+  // Shaders submit their own deletion, which has to happen while the queues still exist.
+  s_Data->Shaders = ShaderLibrary();
+  GPUProfiler::Shutdown();
+  if (s_Data->Threaded) {
+    Flush();
+    {
+      std::lock_guard<std::mutex> lock(s_Data->Mutex);
+      s_Data->Running = false;
+    }
+    s_Data->FrameSubmitted.notify_one();
+    s_Data->Thread.join();
+
+    // Hand the context back, the window still needs it to tear down.
+    s_Data->Context->MakeCurrent();
+  }
+  s_Data->Scratch.Execute();
+  s_Data.reset();
+}
+
+void* Renderer::Allocate(size_t size) {
+  OnyxAssert(s_Data, "Renderer::Allocate called before Renderer::Init!");
+  return s_Data->Threaded ? s_Data->Recording->Allocate(size) : s_Data->Scratch.Allocate(size);
+}
+
+void Renderer::EndFrame() {
+  GPUProfiler::EndFrame();
+  if (!s_Data->Threaded) {
+    ONYX_PROFILE_SCOPE("Renderer::Present");
+    s_Data->Context->SwapBuffers();
+    s_Data->Scratch.Execute();
+    return;
+  }
+
+  GraphicsContext* context = s_Data->Context;
+  Submit([context]() {
+    ONYX_PROFILE_SCOPE("Renderer::Present");
+    context->SwapBuffers();
+  });
+  Kick(s_Data->FramesInFlight);
+}
+
+void Renderer::Flush() {
+  if (s_Data->Threaded) {
+    Kick(0);
+  }
+}
+
+bool Renderer::IsThreaded() { return s_Data && s_Data->Threaded; }
+
+unsigned int Renderer::GetFramesInFlight() { return s_Data ? s_Data->FramesInFlight : 0; }
+
+const RendererStats& Renderer::GetStats() { return s_Data->Stats; }
+
+ShaderLibrary& Renderer::GetShaderLibrary() { return s_Data->Shaders; }
+
+RenderCommandQueue* Renderer::GetSubmitQueue() { return s_Data ? s_Data->Recording : nullptr; }
+}  // namespace Onyx
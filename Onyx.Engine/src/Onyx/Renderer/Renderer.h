@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "Onyx/Core.h"
+#include "Onyx/Renderer/GraphicsContext.h"
+#include "Onyx/Renderer/RenderCommandQueue.h"
+#include "Onyx/Renderer/Shader.h"
+
+namespace Onyx {
+struct RendererStats {
+  // Time the main thread spent blocked on the render thread at the end of the frame.
+  float WaitMs = 0.0f;
+  // Time the render thread took to execute the most recently completed frame.
+  float ExecuteMs = 0.0f;
+  uint32_t CommandCount = 0;
+  size_t CommandBytes = 0;
+};
+
+// Owns the graphics context and the order in which work reaches it. Everything that talks to the
+// graphics API goes through Submit(). Without a render thread commands run immediately; with one,
+// the main thread records frame N+1 while the render thread executes frame N, and may run up to
+// framesInFlight frames ahead before EndFrame() blocks.
+//
+// Submit, Allocate, EndFrame and Flush may only be called from the main thread.
+class ONYX_API Renderer final {
+ public:
+  static void Init(GraphicsContext* context, bool threaded, unsigned int framesInFlight);
+  static void Shutdown();
+
+  // Commands submitted before Init run immediately on the calling thread.
+  template <typename F>
+  static void Submit(F&& fn) {
+    if (RenderCommandQueue* queue = GetSubmitQueue()) {
+      queue->Submit(std::forward<F>(fn));
+    } else {
+      fn();
+    }
+  }
+
+  // Memory that stays valid until the commands of the current frame have executed.
+  static void* Allocate(size_t size);
+
+  // Presents the frame and hands it to the render thread.
+  static void EndFrame();
+  // Executes everything submitted so far and waits for it to complete.
+  static void Flush();
+
+  static bool IsThreaded();
+  static unsigned int GetFramesInFlight();
+  static const RendererStats& GetStats();
+  // Shaders shared across the engine, released before the context goes away.
+  static ShaderLibrary& GetShaderLibrary();
+
+ private:
+  // The queue being recorded, or null when commands should run immediately.
+  static RenderCommandQueue* GetSubmitQueue();
+};
+}  // namespace Onyx
@@ -0,0 +1,252 @@
+#include "pch.h"
+
+#include "Renderer2D.h"
+
+#include <array>
+#include <string>
+
+#include "Onyx/Debug/Profiler.h"
+#include "Onyx/Renderer/RenderCommand.h"
+#include "Onyx/Renderer/Renderer.h"
+#include "Onyx/Renderer/Shader.h"
+#include "Onyx/Renderer/VertexArray.h"
+
+namespace Onyx {
+struct QuadVertex {
+  glm::vec3 Position;
+  glm::vec4 Color;
+  glm::vec2 TexCoord;
+  float TexIndex;
+};
+
+struct Renderer2DData {
+  static constexpr uint32_t MaxQuads = 20000;
+  static constexpr uint32_t MaxVertices = MaxQuads * 4;
+  static constexpr uint32_t MaxIndices = MaxQuads * 6;
+  static constexpr uint32_t MaxTextureSlots = 32;
+  // Batches the streaming vertex buffer can hold before it wraps around.
+  static constexpr uint32_t StreamedBatches = 4;
+
+  Ref<VertexArray> QuadVertexArray;
+  Ref<VertexBuffer> QuadVertexBuffer;
+  Ref<Shader> QuadShader;
+  Ref<Texture2D> WhiteTexture;
+
+  uint32_t QuadIndexCount = 0;
+  QuadVertex* VertexBufferBase = nullptr;
+  QuadVertex* VertexBufferPtr = nullptr;
+
+  std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
+  uint32_t TextureSlotCount = 1;
+  uint32_t TextureSlotIndex = 1;  // Slot 0 is the white texture.
+
+  Renderer2D::Statistics Stats;
+};
+
+static Scope<Renderer2DData> s_Data;
+
+static const char* s_QuadVertexSource = R"(
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in float a_TexIndex;
+
+uniform mat4 u_ViewProjection;
+
+out vec4 v_Color;
+out vec2 v_TexCoord;
+flat out int v_TexIndex;
+
+void main() {
+  v_Color = a_Color;
+  v_TexCoord = a_TexCoord;
+  v_TexIndex = int(a_TexIndex);
+  gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+)";
+
+// Sampler arrays may only be indexed with dynamically uniform values, which a per-vertex slot is
+// not, so every slot gets its own case.
+static std::string BuildQuadFragmentSource(uint32_t slots) {
+  std::string source = R"(
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+
+in vec4 v_Color;
+in vec2 v_TexCoord;
+flat in int v_TexIndex;
+
+)";
+  source += "uniform sampler2D u_Textures[" + std::to_string(slots) + "];\n\n";
+  source += "void main() {\n  vec4 color = vec4(1.0);\n  switch (v_TexIndex) {\n";
+  for (uint32_t i = 0; i < slots; ++i) {
+    const std::string slot = std::to_string(i);
+    source += "    case " + slot + ": color = texture(u_Textures[" + slot + "], v_TexCoord);";
+    source += " break;\n";
+  }
+  source += "  }\n  o_Color = color * v_Color;\n}\n";
+  return source;
+}
+
+void Renderer2D::Init() {
+  ONYX_PROFILE_FUNCTION();
+
+  s_Data = CreateScope<Renderer2DData>();
+
+  s_Data->QuadVertexArray = VertexArray::Create();
+  s_Data->QuadVertexBuffer = VertexBuffer::Create(
+      Renderer2DData::MaxVertices * sizeof(QuadVertex) * Renderer2DData::StreamedBatches);
+  s_Data->QuadVertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
+                                       {ShaderDataType::Float4, "a_Color"},
+                                       {ShaderDataType::Float2, "a_TexCoord"},
+                                       {ShaderDataType::Float, "a_TexIndex"}});
+  s_Data->QuadVertexArray->AddVertexBuffer(s_Data->QuadVertexBuffer);
+
+  std::vector<uint32_t> indices(Renderer2DData::MaxIndices);
+  for (uint32_t i = 0, vertex = 0; i < Renderer2DData::MaxIndices; i += 6, vertex += 4) {
+    indices[i + 0] = vertex + 0;
+    indices[i + 1] = vertex + 1;
+    indices[i + 2] = vertex + 2;
+    indices[i + 3] = vertex + 2;
+    indices[i + 4] = vertex + 3;
+    indices[i + 5] = vertex + 0;
+  }
+  s_Data->QuadVertexArray->SetIndexBuffer(
+      IndexBuffer::Create(indices.data(), Renderer2DData::MaxIndices));
+
+  s_Data->WhiteTexture = Texture2D::Create(1, 1);
+  const uint32_t white = 0xffffffff;
+  s_Data->WhiteTexture->SetData(&white, sizeof(white));
+  s_Data->TextureSlots[0] = s_Data->WhiteTexture;
+
+  s_Data->TextureSlotCount =
+      std::min(RenderCommand::GetCapabilities().MaxTextureSlots, Renderer2DData::MaxTextureSlots);
+  OnyxInfo("Renderer2D batching up to {} textures per draw", s_Data->TextureSlotCount);
+
+  s_Data->QuadShader = Shader::Create("Renderer2D_Quad", s_QuadVertexSource,
+                                      BuildQuadFragmentSource(s_Data->TextureSlotCount));
+  Renderer::GetShaderLibrary().Add(s_Data->QuadShader);
+  std::array<int, Renderer2DData::MaxTextureSlots> samplers;
+  for (uint32_t i = 0; i < s_Data->TextureSlotCount; ++i) {
+    samplers[i] = static_cast<int>(i);
+  }
+  s_Data->QuadShader->SetIntArray("u_Textures", samplers.data(), s_Data->TextureSlotCount);
+}
+
+void Renderer2D::Shutdown() { s_Data.reset(); }
+
+void Renderer2D::BeginScene(const glm::mat4& viewProjection) {
+  s_Data->QuadShader->SetMat4("u_ViewProjection", viewProjection);
+  StartBatch();
+}
+
+void Renderer2D::EndScene() { Flush(); }
+
+void Renderer2D::Flush() {
+  if (s_Data->QuadIndexCount == 0) {
+    return;
+  }
+
+  ONYX_PROFILE_FUNCTION();
+
+  const auto size = static_cast<uint32_t>(
+      reinterpret_cast<unsigned char*>(s_Data->VertexBufferPtr) -
+      reinterpret_cast<unsigned char*>(s_Data->VertexBufferBase));
+  const uint32_t offset = s_Data->QuadVertexBuffer->Stream(s_Data->VertexBufferBase, size);
+
+  for (uint32_t i = 0; i < s_Data->TextureSlotIndex; ++i) {
+    s_Data->TextureSlots[i]->Bind(i);
+  }
+  s_Data->QuadShader->Bind();
+  RenderCommand::DrawIndexed(s_Data->QuadVertexArray, s_Data->QuadIndexCount,
+                             offset / sizeof(QuadVertex));
+  s_Data->Stats.DrawCalls++;
+}
+
+void Renderer2D::StartBatch() {
+  s_Data->QuadIndexCount = 0;
+  s_Data->VertexBufferBase = static_cast<QuadVertex*>(
+      Renderer::Allocate(Renderer2DData::MaxVertices * sizeof(QuadVertex)));
+  s_Data->VertexBufferPtr = s_Data->VertexBufferBase;
+
+  for (uint32_t i = 1; i < s_Data->TextureSlotIndex; ++i) {
+    s_Data->TextureSlots[i] = nullptr;
+  }
+  s_Data->TextureSlotIndex = 1;
+}
+
+void Renderer2D::NextBatch() {
+  Flush();
+  StartBatch();
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size,
+                          const glm::vec4& color) {
+  DrawQuad({position.x, position.y, 0.0f}, size, color);
+}
+
+void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size,
+                          const glm::vec4& color) {
+  PushQuad(position, size, color, 0.0f);
+}
+
+void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size,
+                          const Ref<Texture2D>& texture, const glm::vec4& tint) {
+  DrawQuad({position.x, position.y, 0.0f}, size, texture, tint);
+}
+
+void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size,
+                          const Ref<Texture2D>& texture, const glm::vec4& tint) {
+  // Start a new batch before picking a slot, so the slot belongs to the batch the quad ends up in.
+  if (s_Data->QuadIndexCount >= Renderer2DData::MaxIndices) {
+    NextBatch();
+  }
+
+  uint32_t slot = 0;
+  for (uint32_t i = 1; i < s_Data->TextureSlotIndex; ++i) {
+    if (s_Data->TextureSlots[i] == texture) {
+      slot = i;
+      break;
+    }
+  }
+
+  if (slot == 0) {
+    if (s_Data->TextureSlotIndex >= s_Data->TextureSlotCount) {
+      NextBatch();
+    }
+    slot = s_Data->TextureSlotIndex++;
+    s_Data->TextureSlots[slot] = texture;
+  }
+
+  PushQuad(position, size, tint, static_cast<float>(slot));
+}
+
+void Renderer2D::PushQuad(const glm::vec3& position, const glm::vec2& size,
+                          const glm::vec4& color, float textureIndex) {
+  if (s_Data->QuadIndexCount >= Renderer2DData::MaxIndices) {
+    NextBatch();
+  }
+
+  const float left = position.x - size.x * 0.5f;
+  const float right = position.x + size.x * 0.5f;
+  const float bottom = position.y - size.y * 0.5f;
+  const float top = position.y + size.y * 0.5f;
+
+  QuadVertex* vertex = s_Data->VertexBufferPtr;
+  vertex[0] = {{left, bottom, position.z}, color, {0.0f, 0.0f}, textureIndex};
+  vertex[1] = {{right, bottom, position.z}, color, {1.0f, 0.0f}, textureIndex};
+  vertex[2] = {{right, top, position.z}, color, {1.0f, 1.0f}, textureIndex};
+  vertex[3] = {{left, top, position.z}, color, {0.0f, 1.0f}, textureIndex};
+  s_Data->VertexBufferPtr += 4;
+
+  s_Data->QuadIndexCount += 6;
+  s_Data->Stats.QuadCount++;
+}
+
+const Renderer2D::Statistics& Renderer2D::GetStats() { return s_Data->Stats; }
+
+void Renderer2D::ResetStats() { s_Data->Stats = Statistics(); }
+}  // namespace Onyx
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Onyx/Core.h"
+#include "Onyx/Renderer/Texture.h"
+
+namespace Onyx {
+// Batches quads into as few draws as possible. Vertices are written straight into frame memory
+// and streamed to the GPU in one copy per batch; a batch ends when it is full or runs out of
+// texture slots. Quads are positioned by their center.
+class ONYX_API Renderer2D final {
+ public:
+  struct Statistics {
+    uint32_t DrawCalls = 0;
+    uint32_t QuadCount = 0;
+
+    uint32_t GetTotalVertexCount() const { return QuadCount * 4; }
+    uint32_t GetTotalIndexCount() const { return QuadCount * 6; }
+  };
+
+  static void Init();
+  static void Shutdown();
+
+  static void BeginScene(const glm::mat4& viewProjection);
+  static void EndScene();
+  // Draws everything batched so far.
+  static void Flush();
+
+  static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color);
+  static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+  static void DrawQuad(const glm::vec2& position, const glm::vec2& size,
+                       const Ref<Texture2D>& texture, const glm::vec4& tint = glm::vec4(1.0f));
+  static void DrawQuad(const glm::vec3& position, const glm::vec2& size,
+                       const Ref<Texture2D>& texture, const glm::vec4& tint = glm::vec4(1.0f));
+
+  // Counters since the last ResetStats, which the application calls at the start of every frame.
+  static const Statistics& GetStats();
+  static void ResetStats();
+
+ private:
+  static void StartBatch();
+  static void NextBatch();
+  static void PushQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color,
+                       float textureIndex);
+};
+}  // namespace Onyx
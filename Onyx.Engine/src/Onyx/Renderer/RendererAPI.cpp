@@ -0,0 +1,21 @@
+#include "pch.h"
+
+#include "RendererAPI.h"
+
+#include "Platform/OpenGL/OpenGLRendererAPI.h"
+
+namespace Onyx {
+RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
+
+Scope<RendererAPI> RendererAPI::Create() {
+  switch (s_API) {
+    case API::OpenGL:
+      return CreateScope<OpenGLRendererAPI>();
+    case API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+}  // namespace Onyx
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Onyx/Core.h"
+#include "Onyx/Renderer/VertexArray.h"
+
+namespace Onyx {
+struct RendererCapabilities {
+  // Texture units a single draw can sample from.
+  uint32_t MaxTextureSlots = 1;
+};
+
+// Backend interface behind RenderCommand. Called from the main thread; implementations submit
+// their graphics API calls to the Renderer.
+class ONYX_API RendererAPI {
+ public:
+  enum class API { None = 0, OpenGL = 1 };
+
+  virtual ~RendererAPI() = default;
+
+  virtual void Init() = 0;
+  virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+  virtual void SetClearColor(const glm::vec4& color) = 0;
+  virtual void Clear() = 0;
+
+  // Draws indexCount indices of the vertex array's index buffer, or all of them if zero. Each
+  // index is offset by baseVertex.
+  virtual void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0,
+                           uint32_t baseVertex = 0) = 0;
+
+  // Valid once the commands submitted by Init have executed.
+  virtual const RendererCapabilities& GetCapabilities() const = 0;
+
+  static API GetAPI() { return s_API; }
+  static Scope<RendererAPI> Create();
+
+ private:
+  static API s_API;
+};
+}  // namespace Onyx
@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include "Shader.h"
+
+#include <fstream>
+#include <sstream>
+
+#include "Onyx/Renderer/RendererAPI.h"
+#include "Platform/OpenGL/OpenGLShader.h"
+
+namespace Onyx {
+static std::string s_CacheDirectory = "cache/shaders";
+
+// "assets/shaders/Flat.glsl" -> "Flat"
+static std::string GetNameFromPath(const std::string& filepath) {
+  const size_t slash = filepath.find_last_of("/\\");
+  const size_t begin = slash == std::string::npos ? 0 : slash + 1;
+  const size_t dot = filepath.rfind('.');
+  const size_t end = dot == std::string::npos || dot < begin ? filepath.size() : dot;
+  return filepath.substr(begin, end - begin);
+}
+
+static bool SplitStages(const std::string& filepath, const std::string& source,
+                        std::string& vertexSrc, std::string& fragmentSrc) {
+  static const std::string token = "#type";
+
+  size_t pos = source.find(token);
+  while (pos != std::string::npos) {
+    const size_t lineEnd = source.find_first_of("\r\n", pos);
+    if (lineEnd == std::string::npos) {
+      OnyxError("Shader '{}' ends in a stage without source", filepath);
+      return false;
+    }
+    const size_t typeBegin = source.find_first_not_of(" \t", pos + token.size());
+    const size_t typeEnd = source.find_first_of(" \t\r\n", typeBegin);
+    const std::string type = source.substr(typeBegin, typeEnd - typeBegin);
+
+    const size_t stageBegin = source.find_first_not_of("\r\n", lineEnd);
+    pos = source.find(token, stageBegin);
+    const std::string stage = stageBegin == std::string::npos
+                                  ? std::string()
+                                  : source.substr(stageBegin, pos - stageBegin);
+
+    if (type == "vertex") {
+      vertexSrc = stage;
+    } else if (type == "fragment" || type == "pixel") {
+      fragmentSrc = stage;
+    } else {
+      OnyxError("Unknown shader stage '{}' in '{}'", type, filepath);
+      return false;
+    }
+  }
+
+  if (vertexSrc.empty() || fragmentSrc.empty()) {
+    OnyxError("Shader '{}' needs both a vertex and a fragment stage", filepath);
+    return false;
+  }
+  return true;
+}
+
+Ref<Shader> Shader::Create(const std::string& filepath) {
+  std::ifstream file(filepath, std::ios::binary);
+  if (!file) {
+    OnyxError("Could not open shader '{}'", filepath);
+    return nullptr;
+  }
+  std::stringstream source;
+  source << file.rdbuf();
+
+  std::string vertexSrc, fragmentSrc;
+  if (!SplitStages(filepath, source.str(), vertexSrc, fragmentSrc)) {
+    return nullptr;
+  }
+  return Create(GetNameFromPath(filepath), vertexSrc, fragmentSrc);
+}
+
+Ref<Shader> Shader::Create(const std::string& name, const std::string& vertexSrc,
+                           const std::string& fragmentSrc) {
+  switch (RendererAPI::GetAPI()) {
+    case RendererAPI::API::OpenGL:
+      return CreateRef<OpenGLShader>(name, vertexSrc, fragmentSrc);
+    case RendererAPI::API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+
+void Shader::SetCacheDirectory(const std::string& directory) { s_CacheDirectory = directory; }
+
+const std::string& Shader::GetCacheDirectory() { return s_CacheDirectory; }
+
+void ShaderLibrary::Add(const Ref<Shader>& shader) { Add(shader->GetName(), shader); }
+
+void ShaderLibrary::Add(const std::string& name, const Ref<Shader>& shader) {
+  OnyxAssert(!Exists(name), "Shader '{}' already exists!", name);
+  m_Shaders[name] = shader;
+}
+
+Ref<Shader> ShaderLibrary::Load(const std::string& filepath) {
+  Ref<Shader> shader = Shader::Create(filepath);
+  if (shader) {
+    Add(shader);
+  }
+  return shader;
+}
+
+Ref<Shader> ShaderLibrary::Load(const std::string& name, const std::string& filepath) {
+  Ref<Shader> shader = Shader::Create(filepath);
+  if (shader) {
+    Add(name, shader);
+  }
+  return shader;
+}
+
+Ref<Shader> ShaderLibrary::Get(const std::string& name) const {
+  auto it = m_Shaders.find(name);
+  OnyxAssert(it != m_Shaders.end(), "Shader '{}' not found!", name);
+  return it != m_Shaders.end() ? it->second : nullptr;
+}
+
+bool ShaderLibrary::Exists(const std::string& name) const {
+  return m_Shaders.find(name) != m_Shaders.end();
+}
+}  // namespace Onyx
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <string>
+#include <unordered_map>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+class ONYX_API Shader {
+ public:
+  virtual ~Shader() = default;
+
+  virtual void Bind() const = 0;
+  virtual void Unbind() const = 0;
+
+  virtual void SetInt(const std::string& name, int value) = 0;
+  virtual void SetIntArray(const std::string& name, const int* values, uint32_t count) = 0;
+  virtual void SetFloat4(const std::string& name, const glm::vec4& value) = 0;
+  virtual void SetMat4(const std::string& name, const glm::mat4& value) = 0;
+
+  virtual const std::string& GetName() const = 0;
+
+  // Loads a file holding every stage, each introduced by a "#type vertex" or "#type fragment"
+  // line, and names the shader after the file. Returns nullptr if the file can't be used.
+  static Ref<Shader> Create(const std::string& filepath);
+  static Ref<Shader> Create(const std::string& name, const std::string& vertexSrc,
+                            const std::string& fragmentSrc);
+
+  // Directory linked programs are cached in between runs, keyed by their sources and the driver.
+  // Empty disables the cache. Must be set before Renderer::Init.
+  static void SetCacheDirectory(const std::string& directory);
+  static const std::string& GetCacheDirectory();
+};
+
+// Shaders by name, so they are only loaded once and can be shared.
+class ONYX_API ShaderLibrary final {
+ public:
+  void Add(const Ref<Shader>& shader);
+  void Add(const std::string& name, const Ref<Shader>& shader);
+  Ref<Shader> Load(const std::string& filepath);
+  Ref<Shader> Load(const std::string& name, const std::string& filepath);
+
+  Ref<Shader> Get(const std::string& name) const;
+  bool Exists(const std::string& name) const;
+
+ private:
+  std::unordered_map<std::string, Ref<Shader>> m_Shaders;
+};
+}  // namespace Onyx
@@ -0,0 +1,20 @@
+#include "pch.h"
+
+#include "Texture.h"
+
+#include "Onyx/Renderer/RendererAPI.h"
+#include "Platform/OpenGL/OpenGLTexture.h"
+
+namespace Onyx {
+Ref<Texture2D> Texture2D::Create(uint32_t width, uint32_t height) {
+  switch (RendererAPI::GetAPI()) {
+    case RendererAPI::API::OpenGL:
+      return CreateRef<OpenGLTexture2D>(width, height);
+    case RendererAPI::API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+}  // namespace Onyx
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+class ONYX_API Texture {
+ public:
+  virtual ~Texture() = default;
+
+  virtual uint32_t GetWidth() const = 0;
+  virtual uint32_t GetHeight() const = 0;
+
+  // Replaces the whole texture with tightly packed RGBA8 pixels, copied before returning.
+  virtual void SetData(const void* data, uint32_t size) = 0;
+
+  virtual void Bind(uint32_t slot = 0) const = 0;
+};
+
+class ONYX_API Texture2D : public Texture {
+ public:
+  static Ref<Texture2D> Create(uint32_t width, uint32_t height);
+};
+}  // namespace Onyx
@@ -0,0 +1,20 @@
+#include "pch.h"
+
+#include "TimerQueryPool.h"
+
+#include "Onyx/Renderer/RendererAPI.h"
+#include "Platform/OpenGL/OpenGLTimerQueryPool.h"
+
+namespace Onyx {
+Scope<TimerQueryPool> TimerQueryPool::Create(uint32_t capacity) {
+  switch (RendererAPI::GetAPI()) {
+    case RendererAPI::API::OpenGL:
+      return CreateScope<OpenGLTimerQueryPool>(capacity);
+    case RendererAPI::API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+}  // namespace Onyx
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Onyx/Core.h"
+
+namespace Onyx {
+// A fixed set of GPU timestamp queries, addressed by index. Unlike other renderer objects, a pool
+// is created, used and destroyed from inside submitted commands, on the thread that owns the
+// context. Timestamps are in nanoseconds on the GPU's clock.
+class TimerQueryPool {
+ public:
+  virtual ~TimerQueryPool() = default;
+
+  // False if the driver can't time anything, in which case the pool must not be used.
+  virtual bool IsSupported() const = 0;
+  virtual uint32_t GetCapacity() const = 0;
+
+  // Stores the GPU time at which all previously submitted work has completed.
+  virtual void WriteTimestamp(uint32_t index) = 0;
+  // Whether a written timestamp can be read without waiting for the GPU.
+  virtual bool IsAvailable(uint32_t index) const = 0;
+  virtual uint64_t GetTimestamp(uint32_t index) const = 0;
+  // The GPU's clock right now, for lining its timestamps up with the CPU's.
+  virtual uint64_t GetCurrentTimestamp() const = 0;
+
+  static Scope<TimerQueryPool> Create(uint32_t capacity);
+};
+}  // namespace Onyx
@@ -0,0 +1,20 @@
+#include "pch.h"
+
+#include "VertexArray.h"
+
+#include "Onyx/Renderer/RendererAPI.h"
+#include "Platform/OpenGL/OpenGLVertexArray.h"
+
+namespace Onyx {
+Ref<VertexArray> VertexArray::Create() {
+  switch (RendererAPI::GetAPI()) {
+    case RendererAPI::API::OpenGL:
+      return CreateRef<OpenGLVertexArray>();
+    case RendererAPI::API::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown RendererAPI!");
+  return nullptr;
+}
+}  // namespace Onyx
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Renderer/Buffer.h"
+
+namespace Onyx {
+class ONYX_API VertexArray {
+ public:
+  virtual ~VertexArray() = default;
+
+  virtual void Bind() const = 0;
+  virtual void Unbind() const = 0;
+
+  // The buffer's layout must be set before it is added.
+  virtual void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) = 0;
+  virtual void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) = 0;
+
+  virtual const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const = 0;
+  virtual const Ref<IndexBuffer>& GetIndexBuffer() const = 0;
+
+  static Ref<VertexArray> Create();
+};
+}  // namespace Onyx
@@ -1,9 +1,7 @@
 #pragma once
 
-#include <functional>
-
 #include "Onyx/Core.h"
-#include "Onyx/Events/Event.h"
+#include "Onyx/Events/EventQueue.h"
 #include "Onyx/Renderer/GraphicsContext.h"
 
 namespace Onyx {
@@ -11,6 +9,9 @@ struct WindowProps {
   const char* Title;
   unsigned int Width;
   unsigned int Height;
+  // Create an offscreen context with no native window or input. Only supported on Linux, where it
+  // can also be forced with the ONYX_HEADLESS environment variable.
+  bool Headless = false;
 };
 
 // Struct to be defined by each platform implementation,
@@ -22,8 +23,10 @@ class ONYX_API Window final {
   Window(const WindowProps& props);
   ~Window();
 
+  // Polls for new events. Presenting is left to the Renderer, which owns the context's thread.
   void OnUpdate();
-  void SetCallback(std::function<void(const Event&)> e);
+  // Events received while polling, to be dispatched by the application once per frame.
+  EventQueue& GetEventQueue();
 
   unsigned int GetWidth() const;
   unsigned int GetHeight() const;
@@ -31,8 +34,10 @@ class ONYX_API Window final {
   void SetVSync(bool enabled);
   bool IsVSync() const;
   bool CloseRequested() const;
+  bool IsHeadless() const;
 
   void* GetNativeHandle() const;
+  GraphicsContext* GetContext() const { return m_Context; }
 
  private:
   WindowData* m_Data;
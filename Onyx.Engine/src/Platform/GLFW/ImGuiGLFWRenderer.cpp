@@ -50,10 +50,7 @@
 
 #include "pch.h"
 
-#include "Onyx/Core.h"
-#ifdef ONYX_PLATFORM_WINDOWS
-
-#include "Platform/Windows/ImGuiWindowsRenderer.h"
+#include "Platform/GLFW/ImGuiGLFWRenderer.h"
 #include "imgui.h"
 
 // GLFW
@@ -858,5 +855,3 @@ static void ImGui_ImplGlfw_InitPlatformInterface() {
 }
 
 static void ImGui_ImplGlfw_ShutdownPlatformInterface() {}
-
-#endif /* ONYX_PLATFORM_WINDOWS */
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "pch.h"
+
+#ifdef ONYX_PLATFORM_LINUX
+
+#include "HeadlessOpenGLContext.h"
+
+#include <glad/glad.h>
+
+// Keep Xlib out of the engine, its macros (None, Bool, Status...) collide with our own names.
+#define EGL_NO_X11
+#define MESA_EGL_NO_X11_HEADERS
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <cstring>
+
+#include "Onyx/Core.h"
+#include "Platform/OpenGL/OpenGLExtensions.h"
+#include "Platform/OpenGL/OpenGLState.h"
+
+namespace Onyx {
+static EGLDisplay GetHeadlessDisplay() {
+  // Prefer Mesa's surfaceless platform, which needs neither X11 nor a DRM device.
+  const char* extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (extensions && std::strstr(extensions, "EGL_MESA_platform_surfaceless")) {
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+      EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY,
+                                              nullptr);
+      if (display != EGL_NO_DISPLAY) {
+        return display;
+      }
+    }
+  }
+
+  return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+void HeadlessOpenGLContext::Init() {
+  OnyxInfo("Initializing headless OpenGL renderer...");
+
+  EGLDisplay display = GetHeadlessDisplay();
+  OnyxAssert(display != EGL_NO_DISPLAY, "Failed to get an EGL display!");
+  EGLint major, minor;
+  EGLBoolean init = eglInitialize(display, &major, &minor);
+  OnyxAssert(init, "Failed to initialize EGL!");
+  OnyxInfo("- EGL: {}.{} ({})", major, minor, eglQueryString(display, EGL_VENDOR));
+  m_Display = display;
+
+  eglBindAPI(EGL_OPENGL_API);
+
+  const EGLint pbufferConfigAttribs[] = {EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE,
+                                         EGL_OPENGL_BIT,   EGL_RED_SIZE,    8,
+                                         EGL_GREEN_SIZE,   8,               EGL_BLUE_SIZE,
+                                         8,                EGL_ALPHA_SIZE,  8,
+                                         EGL_DEPTH_SIZE,   24,              EGL_NONE};
+  const EGLint surfacelessConfigAttribs[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+
+  EGLConfig config = nullptr;
+  EGLint configCount = 0;
+  bool pbuffer = eglChooseConfig(display, pbufferConfigAttribs, &config, 1, &configCount) &&
+                 configCount > 0;
+  if (!pbuffer) {
+    eglChooseConfig(display, surfacelessConfigAttribs, &config, 1, &configCount);
+    OnyxAssert(configCount > 0, "No usable EGL config found!");
+  }
+
+  const EGLint contextAttribs[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                   4,
+                                   EGL_CONTEXT_MINOR_VERSION,
+                                   5,
+                                   EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                   EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                   EGL_NONE};
+  EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+  if (context == EGL_NO_CONTEXT) {
+    OnyxWarn("Failed to create an OpenGL 4.5 core context, falling back to the default version");
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, nullptr);
+  }
+  OnyxAssert(context != EGL_NO_CONTEXT, "Failed to create EGL context!");
+  m_Context = context;
+
+  EGLSurface surface = EGL_NO_SURFACE;
+  if (pbuffer) {
+    const EGLint surfaceAttribs[] = {EGL_WIDTH, static_cast<EGLint>(m_Width), EGL_HEIGHT,
+                                     static_cast<EGLint>(m_Height), EGL_NONE};
+    surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+  }
+  m_Surface = surface;
+
+  EGLBoolean current = eglMakeCurrent(display, surface, surface, context);
+  OnyxAssert(current, "Failed to make EGL context current!");
+
+  int glad = gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress));
+  OnyxAssert(glad, "Failed to initialize Glad!");
+
+  // Without a surface there is no default framebuffer, so give the engine one of its own.
+  if (surface == EGL_NO_SURFACE) {
+    OnyxInfo("- No pbuffer support, rendering into an offscreen framebuffer");
+    glGenFramebuffers(1, &m_Framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+    glGenRenderbuffers(2, m_Renderbuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_Renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_Width, m_Height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                              m_Renderbuffers[0]);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_Renderbuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_Width, m_Height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                              m_Renderbuffers[1]);
+    OnyxAssert(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE,
+               "Offscreen framebuffer is incomplete!");
+    glViewport(0, 0, m_Width, m_Height);
+  }
+
+  OnyxInfo("- Vendor: {}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+  OnyxInfo("- Renderer: {}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+  OnyxInfo("- Version: {}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+  if (!GLAD_GL_VERSION_4_5) {
+    OnyxFatal("OpenGL 4.5 is required, the driver only provides {}",
+              reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+  }
+  OnyxAssert(GLAD_GL_VERSION_4_5, "OpenGL 4.5 is required!");
+  OpenGLExtensions::Load(reinterpret_cast<OpenGLExtensions::LoadProc>(eglGetProcAddress));
+  OpenGLState::Invalidate();
+}
+
+void HeadlessOpenGLContext::Shutdown() {
+  if (m_Framebuffer) {
+    glDeleteFramebuffers(1, &m_Framebuffer);
+    glDeleteRenderbuffers(2, m_Renderbuffers);
+    m_Framebuffer = 0;
+  }
+
+  if (m_Display) {
+    eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_Surface) {
+      eglDestroySurface(m_Display, m_Surface);
+    }
+    if (m_Context) {
+      eglDestroyContext(m_Display, m_Context);
+    }
+    eglTerminate(m_Display);
+  }
+  m_Display = m_Context = m_Surface = nullptr;
+}
+
+void HeadlessOpenGLContext::SwapBuffers() {
+  if (m_Surface) {
+    eglSwapBuffers(m_Display, m_Surface);
+  } else {
+    // Nothing to present, but still push the frame's work to the driver like a swap would.
+    glFlush();
+  }
+}
+
+void HeadlessOpenGLContext::MakeCurrent() {
+  // The bound client API is per-thread state in EGL.
+  eglBindAPI(EGL_OPENGL_API);
+  EGLBoolean current = eglMakeCurrent(m_Display, m_Surface, m_Surface, m_Context);
+  OnyxAssert(current, "Failed to make EGL context current!");
+  OpenGLState::Invalidate();
+}
+
+void HeadlessOpenGLContext::ReleaseCurrent() {
+  eglMakeCurrent(m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+}  // namespace Onyx
+
+#endif /* ONYX_PLATFORM_LINUX */
\ No newline at end of file
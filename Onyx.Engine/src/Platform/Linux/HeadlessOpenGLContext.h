@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Onyx/Renderer/GraphicsContext.h"
+
+namespace Onyx {
+// Offscreen OpenGL context created through EGL, for running on machines without a display server
+// (e.g. with Mesa's llvmpipe software rasterizer). Renders into a pbuffer when the EGL
+// implementation offers one, otherwise into a framebuffer object bound as the default target.
+class HeadlessOpenGLContext : public GraphicsContext {
+ public:
+  HeadlessOpenGLContext(unsigned int width, unsigned int height)
+      : m_Width(width), m_Height(height) {}
+
+  void Init() override;
+  void Shutdown() override;
+  void SwapBuffers() override;
+  void MakeCurrent() override;
+  void ReleaseCurrent() override;
+
+ private:
+  unsigned int m_Width;
+  unsigned int m_Height;
+  void* m_Display = nullptr;
+  void* m_Context = nullptr;
+  void* m_Surface = nullptr;
+  unsigned int m_Framebuffer = 0;
+  unsigned int m_Renderbuffers[2] = {0, 0};
+};
+}  // namespace Onyx
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "pch.h"
+
+#include "Onyx/MappedFile.h"
+
+#ifdef ONYX_PLATFORM_LINUX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Onyx {
+MappedFile::MappedFile(const std::string& path) {
+  const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (file < 0) {
+    return;
+  }
+
+  struct stat info;
+  if (fstat(file, &info) == 0 && info.st_size > 0) {
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    if (data != MAP_FAILED) {
+      m_Data = static_cast<const unsigned char*>(data);
+      m_Size = static_cast<size_t>(info.st_size);
+    }
+  }
+  // The mapping keeps the file alive on its own.
+  close(file);
+}
+
+MappedFile::~MappedFile() {
+  if (m_Data) {
+    munmap(const_cast<unsigned char*>(m_Data), m_Size);
+  }
+}
+}  // namespace Onyx
+#endif /* ONYX_PLATFORM_LINUX */
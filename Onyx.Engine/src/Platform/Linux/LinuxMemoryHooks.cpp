@@ -0,0 +1,36 @@
+#include "pch.h"
+
+#include "Onyx/Debug/MemoryTracker.h"
+
+// Symbols in the engine's shared object take the place of the standard library's for the whole
+// process, so every module's operator new ends up here. Over-aligned allocations keep the default
+// operators and aren't counted.
+#if defined(ONYX_PLATFORM_LINUX) && ONYX_MEMORY_TRACKING
+#include <new>
+
+static void* AllocateOrThrow(size_t size) {
+  void* ptr = Onyx::MemoryTracker::Allocate(size);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new(size_t size) { return AllocateOrThrow(size); }
+void* operator new[](size_t size) { return AllocateOrThrow(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  return Onyx::MemoryTracker::Allocate(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+  return Onyx::MemoryTracker::Allocate(size);
+}
+
+void operator delete(void* ptr) noexcept { Onyx::MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr) noexcept { Onyx::MemoryTracker::Free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { Onyx::MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { Onyx::MemoryTracker::Free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { Onyx::MemoryTracker::Free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  Onyx::MemoryTracker::Free(ptr);
+}
+#endif
@@ -0,0 +1,181 @@
+#include "pch.h"
+
+#ifdef ONYX_PLATFORM_LINUX
+
+#include <GLFW/glfw3.h>
+
+#include <cstdlib>
+
+#include "Onyx/Debug/Profiler.h"
+#include "Onyx/Events/EventQueue.h"
+#include "Onyx/Renderer/Renderer.h"
+#include "Onyx/Window.h"
+#include "Platform/Linux/HeadlessOpenGLContext.h"
+#include "Platform/OpenGL/OpenGLContext.h"
+
+namespace Onyx {
+struct WindowData {
+  GLFWwindow* Window = nullptr;
+  unsigned int Width = 0;
+  unsigned int Height = 0;
+  bool VSync = false;
+  bool Headless = false;
+  EventQueue Events;
+};
+
+static void GLFWError(int error, const char* description) {
+  OnyxError("GLFW Error {0}: {1}", error, description);
+}
+
+static bool HeadlessRequested(const WindowProps& props) {
+  const char* env = std::getenv("ONYX_HEADLESS");
+  return props.Headless || (env && env[0] != '\0' && env[0] != '0');
+}
+
+Window::Window(const WindowProps& props) {
+  m_Data = new WindowData();
+  m_Data->Width = props.Width;
+  m_Data->Height = props.Height;
+  m_Data->Headless = HeadlessRequested(props);
+
+  if (m_Data->Headless) {
+    OnyxInfo("Creating headless context of size {0}x{1}", m_Data->Width, m_Data->Height);
+    m_Context = new HeadlessOpenGLContext(m_Data->Width, m_Data->Height);
+    m_Context->Init();
+    return;
+  }
+
+  OnyxInfo("Creating window of size {0}x{1}", m_Data->Width, m_Data->Height);
+
+  int init = glfwInit();
+  OnyxAssert(init, "Failed to initialize GLFW");
+  glfwSetErrorCallback(GLFWError);
+
+  // The renderer relies on direct state access, which is core from 4.5 on.
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  m_Data->Window = glfwCreateWindow(m_Data->Width, m_Data->Height, props.Title, nullptr, nullptr);
+  if (!m_Data->Window) {
+    OnyxFatal("Failed to create a window with an OpenGL 4.5 core context");
+  }
+  OnyxAssert(m_Data->Window, "Failed to create window!");
+
+  // Center window on the screen
+  GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+  const GLFWvidmode* mode = glfwGetVideoMode(monitor);
+  int monitorX, monitorY;
+  glfwGetMonitorPos(monitor, &monitorX, &monitorY);
+  int windowW, windowH;
+  glfwGetWindowSize(m_Data->Window, &windowW, &windowH);
+  glfwSetWindowPos(m_Data->Window, monitorX + (mode->width - windowW) / 2,
+                   monitorY + (mode->height - windowH) / 2);
+  glfwSetWindowUserPointer(m_Data->Window, m_Data);
+
+  m_Context = new OpenGLContext(m_Data->Window);
+  m_Context->Init();
+
+  SetVSync(true);
+
+  glfwSetWindowSizeCallback(m_Data->Window, [](GLFWwindow* window, int width, int height) {
+    WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
+    data.Width = width;
+    data.Height = height;
+
+    data.Events.Push(QueuedEvent::WindowResized(width, height));
+  });
+
+  glfwSetWindowCloseCallback(m_Data->Window, [](GLFWwindow* window) {
+    WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
+    data.Events.Push(QueuedEvent::WindowClosed());
+  });
+
+  glfwSetKeyCallback(
+      m_Data->Window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
+        WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
+        switch (action) {
+          case GLFW_PRESS:
+          case GLFW_REPEAT:
+            data.Events.Push(QueuedEvent::Key(EventType::KeyPressed, key));
+            break;
+          case GLFW_RELEASE:
+            data.Events.Push(QueuedEvent::Key(EventType::KeyReleased, key));
+            break;
+        }
+      });
+
+  glfwSetCharCallback(m_Data->Window, [](GLFWwindow* window, unsigned int keycode) {
+    WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
+
+    data.Events.Push(QueuedEvent::Key(EventType::KeyTyped, keycode));
+  });
+
+  glfwSetMouseButtonCallback(
+      m_Data->Window, [](GLFWwindow* window, int button, int action, int mods) {
+        WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
+        switch (action) {
+          case GLFW_PRESS:
+            data.Events.Push(QueuedEvent::Mouse(EventType::MousePressed, button));
+            break;
+          case GLFW_RELEASE:
+            data.Events.Push(QueuedEvent::Mouse(EventType::MouseReleased, button));
+            break;
+        }
+      });
+
+  glfwSetScrollCallback(m_Data->Window, [](GLFWwindow* window, double x, double y) {
+    WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
+    data.Events.Push(QueuedEvent::MouseScrolled(y));
+  });
+
+  glfwSetCursorPosCallback(m_Data->Window, [](GLFWwindow* window, double x, double y) {
+    WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
+    data.Events.Push(QueuedEvent::MouseMoved(x, y));
+  });
+}
+
+Window::~Window() {
+  m_Context->Shutdown();
+  delete m_Context;
+  if (m_Data->Window) {
+    glfwDestroyWindow(m_Data->Window);
+    glfwTerminate();
+  }
+  delete m_Data;
+}
+
+void Window::OnUpdate() {
+  ONYX_PROFILE_FUNCTION();
+
+  if (m_Data->Window) {
+    glfwPollEvents();
+  }
+}
+
+EventQueue& Window::GetEventQueue() { return m_Data->Events; }
+
+unsigned int Window::GetWidth() const { return m_Data->Width; };
+
+unsigned int Window::GetHeight() const { return m_Data->Height; };
+
+void* Window::GetNativeHandle() const { return reinterpret_cast<void*>(m_Data->Window); }
+
+void Window::SetVSync(bool enabled) {
+  // An offscreen context never presents, so there is nothing to synchronize with.
+  if (m_Data->Window) {
+    // Swap interval applies to the thread the context is current on.
+    Renderer::Submit([enabled]() { glfwSwapInterval(enabled ? 1 : 0); });
+  }
+  m_Data->VSync = enabled;
+}
+
+bool Window::IsVSync() const { return m_Data->VSync; }
+
+bool Window::CloseRequested() const {
+  return m_Data->Window && glfwWindowShouldClose(m_Data->Window);
+}
+
+bool Window::IsHeadless() const { return m_Data->Headless; }
+}  // namespace Onyx
+
+#endif /* ONYX_PLATFORM_LINUX */
\ No newline at end of file
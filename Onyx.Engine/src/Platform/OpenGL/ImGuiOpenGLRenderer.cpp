@@ -85,9 +85,15 @@
 #endif
 
 #include <stdio.h>
+#include <string.h>
 
 #include "imgui.h"
+#include "Onyx/Debug/Profiler.h"
+#include "Onyx/Renderer/GPUProfiler.h"
 #include "Platform/OpenGL/ImGuiOpenGLRenderer.h"
+#include "Platform/OpenGL/OpenGLShader.h"
+#include "Platform/OpenGL/OpenGLState.h"
+#include "Platform/OpenGL/OpenGLStreamBuffer.h"
 #if defined(_MSC_VER) && _MSC_VER <= 1500  // MSVC 2008 or earlier
 #include <stddef.h>                        // intptr_t
 #else
@@ -151,11 +157,28 @@ static GLuint g_GlVersion = 0;  // Extracted at runtime using GL_MAJOR_VERSION,
 static char g_GlslVersionString[32] =
     "";  // Specified by user or detected based on compile time GL settings.
 static GLuint g_FontTexture = 0;
-static GLuint g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
+static bool g_ClipOriginLowerLeft = true;  // Queried once, the engine never changes clip control
+static GLuint g_ShaderHandle = 0;
 static GLint g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;  // Uniforms location
 static GLuint g_AttribLocationVtxPos = 0, g_AttribLocationVtxUV = 0,
               g_AttribLocationVtxColor = 0;  // Vertex attributes location
-static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
+// Vertex and index data is streamed through persistently mapped rings that hold several frames of
+// UI, so uploads never reallocate. A ring is regrown when a frame would not fit in half of it.
+static const uint32_t g_InitialStreamSize = 4 * 1024 * 1024;
+static Onyx::OpenGLStreamBuffer* g_VertexStream = NULL;
+static Onyx::OpenGLStreamBuffer* g_IndexStream = NULL;
+
+// Consecutive draw commands sharing a texture and scissor rectangle, issued as one multi-draw.
+// Kept across frames so its arrays are only ever grown.
+struct ImGui_ImplOpenGL3_DrawBatch {
+  GLuint Texture;
+  GLint Scissor[4];
+  bool HasState;  // Texture and Scissor match what is bound
+  ImVector<GLsizei> Counts;
+  ImVector<const void*> Offsets;
+  ImVector<GLint> BaseVertices;
+};
+static ImGui_ImplOpenGL3_DrawBatch g_Batch = {};
 
 // Forward Declarations
 static void ImGui_ImplOpenGL3_InitPlatformInterface();
@@ -246,38 +269,52 @@ void ImGui_ImplOpenGL3_NewFrame() {
   if (!g_ShaderHandle) ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
+static void ImGui_ImplOpenGL3_ReserveStream(Onyx::OpenGLStreamBuffer*& stream, size_t frame_size) {
+  if (stream && frame_size <= stream->GetSize() / 2) return;
+  uint32_t size = stream ? stream->GetSize() : g_InitialStreamSize;
+  while (frame_size > size / 2) size *= 2;
+  delete stream;
+  stream = new Onyx::OpenGLStreamBuffer(size);
+}
+
+static void ImGui_ImplOpenGL3_FlushBatch() {
+  ImGui_ImplOpenGL3_DrawBatch& batch = g_Batch;
+  if (batch.Counts.Size == 0) return;
+  const GLenum type = sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+  if (batch.Counts.Size == 1)
+    glDrawElementsBaseVertex(GL_TRIANGLES, batch.Counts[0], type, batch.Offsets[0],
+                             batch.BaseVertices[0]);
+  else
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, batch.Counts.Data, type, batch.Offsets.Data,
+                                  (GLsizei)batch.Counts.Size, batch.BaseVertices.Data);
+  batch.Counts.resize(0);
+  batch.Offsets.resize(0);
+  batch.BaseVertices.resize(0);
+}
+
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height,
                                                GLuint vertex_array_object) {
   // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled,
-  // polygon fill
-  glEnable(GL_BLEND);
-  glBlendEquation(GL_FUNC_ADD);
-  glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-  glDisable(GL_CULL_FACE);
-  glDisable(GL_DEPTH_TEST);
-  glEnable(GL_SCISSOR_TEST);
-#ifdef GL_POLYGON_MODE
-  glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-#endif
-
-  // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
-  bool clip_origin_lower_left = true;
-#if defined(GL_CLIP_ORIGIN) && !defined(__APPLE__)
-  GLenum current_clip_origin = 0;
-  glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
-  if (current_clip_origin == GL_UPPER_LEFT) clip_origin_lower_left = false;
-#endif
+  // polygon fill. All of it goes through the engine's state tracker, which drops redundant calls
+  // and makes the glGet-based backup and restore unnecessary.
+  Onyx::OpenGLState::SetEnabled(GL_BLEND, true);
+  Onyx::OpenGLState::SetBlendEquation(GL_FUNC_ADD);
+  Onyx::OpenGLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  Onyx::OpenGLState::SetEnabled(GL_CULL_FACE, false);
+  Onyx::OpenGLState::SetEnabled(GL_DEPTH_TEST, false);
+  Onyx::OpenGLState::SetEnabled(GL_SCISSOR_TEST, true);
+  Onyx::OpenGLState::SetPolygonMode(GL_FILL);
 
   // Setup viewport, orthographic projection matrix
   // Our visible imgui space lies from draw_data->DisplayPos (top left) to
   // draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single
   // viewport apps.
-  glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height);
+  Onyx::OpenGLState::SetViewport(0, 0, fb_width, fb_height);
   float L = draw_data->DisplayPos.x;
   float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
   float T = draw_data->DisplayPos.y;
   float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
-  if (!clip_origin_lower_left) {
+  if (!g_ClipOriginLowerLeft) {
     float tmp = T;
     T = B;
     B = tmp;
@@ -288,22 +325,15 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
       {0.0f, 0.0f, -1.0f, 0.0f},
       {(R + L) / (L - R), (T + B) / (B - T), 0.0f, 1.0f},
   };
-  glUseProgram(g_ShaderHandle);
+  Onyx::OpenGLState::UseProgram(g_ShaderHandle);
   glUniform1i(g_AttribLocationTex, 0);
   glUniformMatrix4fv(g_AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
-#ifdef GL_SAMPLER_BINDING
-  glBindSampler(0, 0);  // We use combined texture/sampler state. Applications using GL 3.3 may set
-                        // that otherwise.
-#endif
-
-  (void)vertex_array_object;
-#ifndef IMGUI_IMPL_OPENGL_ES2
-  glBindVertexArray(vertex_array_object);
-#endif
+  Onyx::OpenGLState::BindSampler(0, 0);  // We use combined texture/sampler state
+  Onyx::OpenGLState::BindVertexArray(vertex_array_object);
 
   // Bind vertex/index buffers and setup attributes for ImDrawVert
-  glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+  Onyx::OpenGLState::BindBuffer(GL_ARRAY_BUFFER, g_VertexStream->GetRendererID());
+  Onyx::OpenGLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_IndexStream->GetRendererID());
   glEnableVertexAttribArray(g_AttribLocationVtxPos);
   glEnableVertexAttribArray(g_AttribLocationVtxUV);
   glEnableVertexAttribArray(g_AttribLocationVtxColor);
@@ -317,9 +347,8 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 
 // OpenGL3 Render function.
 // (this used to be set in io.RenderDrawListsFn and called by ImGui::Render(), but you can now call
-// this directly from your main loop) Note that this implementation is little overcomplicated
-// because we are saving/setting up/restoring every OpenGL state explicitly, in order to be able to
-// run within any OpenGL engine that doesn't do so.
+// this directly from your main loop) State is set through Onyx::OpenGLState and not restored
+// afterwards; engine draws reapply what they need through the same tracker.
 void ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data) {
   // Avoid rendering when minimized, scale coordinates for retina displays (screen coordinates !=
   // framebuffer coordinates)
@@ -327,57 +356,18 @@ void ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data) {
   int fb_height = (int)(draw_data->DisplaySize.y * draw_data->FramebufferScale.y);
   if (fb_width <= 0 || fb_height <= 0) return;
 
-  // Backup GL state
-  GLenum last_active_texture;
-  glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-  glActiveTexture(GL_TEXTURE0);
-  GLuint last_program;
-  glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-  GLuint last_texture;
-  glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef GL_SAMPLER_BINDING
-  GLuint last_sampler;
-  glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler);
-#endif
-  GLuint last_array_buffer;
-  glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_ES2
-  GLuint last_vertex_array_object;
-  glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef GL_POLYGON_MODE
-  GLint last_polygon_mode[2];
-  glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
-#endif
-  GLint last_viewport[4];
-  glGetIntegerv(GL_VIEWPORT, last_viewport);
-  GLint last_scissor_box[4];
-  glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-  GLenum last_blend_src_rgb;
-  glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-  GLenum last_blend_dst_rgb;
-  glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-  GLenum last_blend_src_alpha;
-  glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-  GLenum last_blend_dst_alpha;
-  glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-  GLenum last_blend_equation_rgb;
-  glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-  GLenum last_blend_equation_alpha;
-  glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-  GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-  GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-  GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-  GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+  // Make sure the whole frame fits before binding the rings, so they are never replaced mid-frame
+  ImGui_ImplOpenGL3_ReserveStream(g_VertexStream,
+                                  (size_t)draw_data->TotalVtxCount * sizeof(ImDrawVert));
+  ImGui_ImplOpenGL3_ReserveStream(g_IndexStream,
+                                  (size_t)draw_data->TotalIdxCount * sizeof(ImDrawIdx));
 
   // Setup desired GL state
   // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to.
   // VAO are not shared among GL contexts) The renderer would actually work without any VAO bound,
   // but then our VertexAttrib calls would overwrite the default one currently bound.
   GLuint vertex_array_object = 0;
-#ifndef IMGUI_IMPL_OPENGL_ES2
   glGenVertexArrays(1, &vertex_array_object);
-#endif
   ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
   // Will project scissor/clipping rectangles into framebuffer space
@@ -385,27 +375,50 @@ void ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data) {
   ImVec2 clip_scale =
       draw_data->FramebufferScale;  // (1,1) unless using retina display which are often (2,2)
 
-  // Render command lists
+  // Upload all command lists back to back into one range of each ring, so the whole viewport
+  // draws from a single binding and only offsets change between draws. Vertices are aligned to
+  // their stride so their offset can be passed as a base vertex.
+  const uint32_t vtx_offset = g_VertexStream->Allocate(
+      (uint32_t)(draw_data->TotalVtxCount * sizeof(ImDrawVert)), (uint32_t)sizeof(ImDrawVert));
+  const uint32_t idx_offset = g_IndexStream->Allocate(
+      (uint32_t)(draw_data->TotalIdxCount * sizeof(ImDrawIdx)), (uint32_t)sizeof(ImDrawIdx));
+  {
+    uint32_t vtx_write = vtx_offset, idx_write = idx_offset;
+    for (int n = 0; n < draw_data->CmdListsCount; n++) {
+      const ImDrawList* cmd_list = draw_data->CmdLists[n];
+      const uint32_t vtx_size = (uint32_t)(cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+      const uint32_t idx_size = (uint32_t)(cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+      g_VertexStream->Write(vtx_write, cmd_list->VtxBuffer.Data, vtx_size);
+      g_IndexStream->Write(idx_write, cmd_list->IdxBuffer.Data, idx_size);
+      vtx_write += vtx_size;
+      idx_write += idx_size;
+    }
+  }
+
+  // Render command lists. Draws are gathered into batches that only break when the texture or
+  // scissor rectangle changes, or a callback needs to run.
+  ImGui_ImplOpenGL3_DrawBatch& batch = g_Batch;
+  batch.HasState = false;
+  GLint global_vtx_offset = (GLint)(vtx_offset / sizeof(ImDrawVert));
+  size_t global_idx_offset = idx_offset;
   for (int n = 0; n < draw_data->CmdListsCount; n++) {
     const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
-    // Upload vertex/index buffers
-    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert),
-                 (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                 (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx),
-                 (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
-
     for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++) {
       const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
       if (pcmd->UserCallback != NULL) {
         // User callback, registered via ImDrawList::AddCallback()
         // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request
         // the renderer to reset render state.)
+        ImGui_ImplOpenGL3_FlushBatch();
+        batch.HasState = false;
         if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
           ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
-        else
+        else {
+          // The callback may change GL state behind the tracker's back
           pcmd->UserCallback(cmd_list, pcmd);
+          Onyx::OpenGLState::Invalidate();
+        }
       } else {
         // Project scissor/clipping rectangles into framebuffer space
         ImVec4 clip_rect;
@@ -416,70 +429,45 @@ void ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data) {
 
         if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f &&
             clip_rect.w >= 0.0f) {
-          // Apply scissor/clipping rectangle
-          glScissor((int)clip_rect.x, (int)(fb_height - clip_rect.w),
-                    (int)(clip_rect.z - clip_rect.x), (int)(clip_rect.w - clip_rect.y));
-
-          // Bind texture, Draw
-          glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
-#if IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
-          if (g_GlVersion >= 320)
-            glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount,
-                                     sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
-                                     (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)),
-                                     (GLint)pcmd->VtxOffset);
-          else
-#endif
-            glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount,
-                           sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT,
-                           (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+          // Apply scissor/clipping rectangle and texture, starting a new batch if either changes
+          const GLint scissor[4] = {(GLint)clip_rect.x, (GLint)(fb_height - clip_rect.w),
+                                    (GLint)(clip_rect.z - clip_rect.x),
+                                    (GLint)(clip_rect.w - clip_rect.y)};
+          const GLuint texture = (GLuint)(intptr_t)pcmd->TextureId;
+          const bool same_scissor =
+              batch.HasState && memcmp(scissor, batch.Scissor, sizeof(scissor)) == 0;
+          const bool same_texture = batch.HasState && texture == batch.Texture;
+          if (!same_scissor || !same_texture) {
+            ImGui_ImplOpenGL3_FlushBatch();
+            Onyx::OpenGLState::SetScissor(scissor[0], scissor[1], scissor[2], scissor[3]);
+            Onyx::OpenGLState::BindTextureUnit(0, texture);
+            memcpy(batch.Scissor, scissor, sizeof(scissor));
+            batch.Texture = texture;
+            batch.HasState = true;
+          }
+
+          // Draw. The ring offsets make the base vertex mandatory; the stream buffers already
+          // require the DSA entry points of GL 4.5, so it is always available.
+          batch.Counts.push_back((GLsizei)pcmd->ElemCount);
+          batch.Offsets.push_back(
+              (const void*)(intptr_t)(global_idx_offset + pcmd->IdxOffset * sizeof(ImDrawIdx)));
+          batch.BaseVertices.push_back(global_vtx_offset + (GLint)pcmd->VtxOffset);
         }
       }
     }
+    global_vtx_offset += cmd_list->VtxBuffer.Size;
+    global_idx_offset += cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx);
   }
+  ImGui_ImplOpenGL3_FlushBatch();
+
+  // All of this frame's data was written before the draws above, so fence it now that they are
+  // submitted; otherwise the rings would fence it ahead of them.
+  g_VertexStream->Fence();
+  g_IndexStream->Fence();
 
   // Destroy the temporary VAO
-#ifndef IMGUI_IMPL_OPENGL_ES2
+  Onyx::OpenGLState::ForgetVertexArray(vertex_array_object);
   glDeleteVertexArrays(1, &vertex_array_object);
-#endif
-
-  // Restore modified GL state
-  glUseProgram(last_program);
-  glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef GL_SAMPLER_BINDING
-  glBindSampler(0, last_sampler);
-#endif
-  glActiveTexture(last_active_texture);
-#ifndef IMGUI_IMPL_OPENGL_ES2
-  glBindVertexArray(last_vertex_array_object);
-#endif
-  glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-  glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-  glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha,
-                      last_blend_dst_alpha);
-  if (last_enable_blend)
-    glEnable(GL_BLEND);
-  else
-    glDisable(GL_BLEND);
-  if (last_enable_cull_face)
-    glEnable(GL_CULL_FACE);
-  else
-    glDisable(GL_CULL_FACE);
-  if (last_enable_depth_test)
-    glEnable(GL_DEPTH_TEST);
-  else
-    glDisable(GL_DEPTH_TEST);
-  if (last_enable_scissor_test)
-    glEnable(GL_SCISSOR_TEST);
-  else
-    glDisable(GL_SCISSOR_TEST);
-#ifdef GL_POLYGON_MODE
-  glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]);
-#endif
-  glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2],
-             (GLsizei)last_viewport[3]);
-  glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2],
-            (GLsizei)last_scissor_box[3]);
 }
 
 bool ImGui_ImplOpenGL3_CreateFontsTexture() {
@@ -494,81 +482,35 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture() {
                  // ImTextureId represent a higher-level concept than just a GL texture id, consider
                  // calling GetTexDataAsAlpha8() instead to save on GPU memory.
 
-  // Upload texture to graphics system
-  GLint last_texture;
-  glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-  glGenTextures(1, &g_FontTexture);
-  glBindTexture(GL_TEXTURE_2D, g_FontTexture);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-#ifdef GL_UNPACK_ROW_LENGTH
+  // Upload texture to graphics system, without touching any binding
+  glCreateTextures(GL_TEXTURE_2D, 1, &g_FontTexture);
+  glTextureParameteri(g_FontTexture, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTextureParameteri(g_FontTexture, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
   glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-#endif
-  glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+  glTextureStorage2D(g_FontTexture, 1, GL_RGBA8, width, height);
+  glTextureSubImage2D(g_FontTexture, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
   // Store our identifier
   io.Fonts->TexID = (ImTextureID)(intptr_t)g_FontTexture;
 
-  // Restore state
-  glBindTexture(GL_TEXTURE_2D, last_texture);
-
   return true;
 }
 
 void ImGui_ImplOpenGL3_DestroyFontsTexture() {
   if (g_FontTexture) {
     ImGuiIO& io = ImGui::GetIO();
+    Onyx::OpenGLState::ForgetTexture(g_FontTexture);
     glDeleteTextures(1, &g_FontTexture);
     io.Fonts->TexID = 0;
     g_FontTexture = 0;
   }
 }
 
-// If you get an error please report on github. You may try different GL context version or GLSL
-// version. See GL<>GLSL version table at the top of this file.
-static bool CheckShader(GLuint handle, const char* desc) {
-  GLint status = 0, log_length = 0;
-  glGetShaderiv(handle, GL_COMPILE_STATUS, &status);
-  glGetShaderiv(handle, GL_INFO_LOG_LENGTH, &log_length);
-  if ((GLboolean)status == GL_FALSE)
-    fprintf(stderr, "ERROR: ImGui_ImplOpenGL3_CreateDeviceObjects: failed to compile %s!\n", desc);
-  if (log_length > 1) {
-    ImVector<char> buf;
-    buf.resize((int)(log_length + 1));
-    glGetShaderInfoLog(handle, log_length, NULL, (GLchar*)buf.begin());
-    fprintf(stderr, "%s\n", buf.begin());
-  }
-  return (GLboolean)status == GL_TRUE;
-}
-
-// If you get an error please report on GitHub. You may try different GL context version or GLSL
-// version.
-static bool CheckProgram(GLuint handle, const char* desc) {
-  GLint status = 0, log_length = 0;
-  glGetProgramiv(handle, GL_LINK_STATUS, &status);
-  glGetProgramiv(handle, GL_INFO_LOG_LENGTH, &log_length);
-  if ((GLboolean)status == GL_FALSE)
-    fprintf(stderr,
-            "ERROR: ImGui_ImplOpenGL3_CreateDeviceObjects: failed to link %s! (with GLSL '%s')\n",
-            desc, g_GlslVersionString);
-  if (log_length > 1) {
-    ImVector<char> buf;
-    buf.resize((int)(log_length + 1));
-    glGetProgramInfoLog(handle, log_length, NULL, (GLchar*)buf.begin());
-    fprintf(stderr, "%s\n", buf.begin());
-  }
-  return (GLboolean)status == GL_TRUE;
-}
-
 bool ImGui_ImplOpenGL3_CreateDeviceObjects() {
-  // Backup GL state
-  GLint last_texture, last_array_buffer;
-  glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
-  glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_ES2
-  GLint last_vertex_array;
-  glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &last_vertex_array);
-#endif
+  // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
+  GLenum current_clip_origin = 0;
+  glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
+  g_ClipOriginLowerLeft = current_clip_origin != GL_UPPER_LEFT;
 
   // Parse GLSL version string
   int glsl_version = 130;
@@ -691,24 +633,11 @@ bool ImGui_ImplOpenGL3_CreateDeviceObjects() {
     fragment_shader = fragment_shader_glsl_130;
   }
 
-  // Create shaders
-  const GLchar* vertex_shader_with_version[2] = {g_GlslVersionString, vertex_shader};
-  g_VertHandle = glCreateShader(GL_VERTEX_SHADER);
-  glShaderSource(g_VertHandle, 2, vertex_shader_with_version, NULL);
-  glCompileShader(g_VertHandle);
-  CheckShader(g_VertHandle, "vertex shader");
-
-  const GLchar* fragment_shader_with_version[2] = {g_GlslVersionString, fragment_shader};
-  g_FragHandle = glCreateShader(GL_FRAGMENT_SHADER);
-  glShaderSource(g_FragHandle, 2, fragment_shader_with_version, NULL);
-  glCompileShader(g_FragHandle);
-  CheckShader(g_FragHandle, "fragment shader");
-
-  g_ShaderHandle = glCreateProgram();
-  glAttachShader(g_ShaderHandle, g_VertHandle);
-  glAttachShader(g_ShaderHandle, g_FragHandle);
-  glLinkProgram(g_ShaderHandle);
-  CheckProgram(g_ShaderHandle, "shader program");
+  // Create shaders. Linking goes through the engine, which logs failures and reuses the program
+  // binary from an earlier run when the sources and driver are unchanged.
+  g_ShaderHandle =
+      Onyx::OpenGLShader::LinkProgram("ImGui", std::string(g_GlslVersionString) + vertex_shader,
+                                      std::string(g_GlslVersionString) + fragment_shader);
 
   g_AttribLocationTex = glGetUniformLocation(g_ShaderHandle, "Texture");
   g_AttribLocationProjMtx = glGetUniformLocation(g_ShaderHandle, "ProjMtx");
@@ -717,45 +646,24 @@ bool ImGui_ImplOpenGL3_CreateDeviceObjects() {
   g_AttribLocationVtxColor = (GLuint)glGetAttribLocation(g_ShaderHandle, "Color");
 
   // Create buffers
-  glGenBuffers(1, &g_VboHandle);
-  glGenBuffers(1, &g_ElementsHandle);
+  ImGui_ImplOpenGL3_ReserveStream(g_VertexStream, 0);
+  ImGui_ImplOpenGL3_ReserveStream(g_IndexStream, 0);
 
   ImGui_ImplOpenGL3_CreateFontsTexture();
 
-  // Restore modified GL state
-  glBindTexture(GL_TEXTURE_2D, last_texture);
-  glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_ES2
-  glBindVertexArray(last_vertex_array);
-#endif
-
   return true;
 }
 
 void ImGui_ImplOpenGL3_DestroyDeviceObjects() {
-  if (g_VboHandle) {
-    glDeleteBuffers(1, &g_VboHandle);
-    g_VboHandle = 0;
-  }
-  if (g_ElementsHandle) {
-    glDeleteBuffers(1, &g_ElementsHandle);
-    g_ElementsHandle = 0;
-  }
-  if (g_ShaderHandle && g_VertHandle) {
-    glDetachShader(g_ShaderHandle, g_VertHandle);
-  }
-  if (g_ShaderHandle && g_FragHandle) {
-    glDetachShader(g_ShaderHandle, g_FragHandle);
-  }
-  if (g_VertHandle) {
-    glDeleteShader(g_VertHandle);
-    g_VertHandle = 0;
-  }
-  if (g_FragHandle) {
-    glDeleteShader(g_FragHandle);
-    g_FragHandle = 0;
-  }
+  delete g_VertexStream;
+  g_VertexStream = NULL;
+  delete g_IndexStream;
+  g_IndexStream = NULL;
+  g_Batch.Counts.clear();
+  g_Batch.Offsets.clear();
+  g_Batch.BaseVertices.clear();
   if (g_ShaderHandle) {
+    Onyx::OpenGLState::ForgetProgram(g_ShaderHandle);
     glDeleteProgram(g_ShaderHandle);
     g_ShaderHandle = 0;
   }
@@ -770,18 +678,80 @@ void ImGui_ImplOpenGL3_DestroyDeviceObjects() {
 // it is recommended that you completely ignore this section first..
 //--------------------------------------------------------------------------------------------------------
 
+// Query objects aren't shared between contexts, so instead of going through the GPUProfiler's
+// pool each platform window times itself with a small ring of its own, read back once the ring
+// comes around again. The queries go away with the window's context.
+struct ImGui_ImplOpenGL3_ViewportTimer {
+  static const int Count = Onyx::GPUProfiler::FrameLatency;
+
+  GLuint Queries[Count];
+  uint64_t Starts[Count];  // Profiler time each was issued at, where the export places it
+  bool Pending[Count];
+  int Next;
+
+  ImGui_ImplOpenGL3_ViewportTimer() : Next(0) {
+    glCreateQueries(GL_TIME_ELAPSED, Count, Queries);
+    memset(Starts, 0, sizeof(Starts));
+    memset(Pending, 0, sizeof(Pending));
+  }
+
+  void Begin() {
+    const int slot = Next;
+    if (Pending[slot]) {
+      GLint available = GL_FALSE;
+      glGetQueryObjectiv(Queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+      if (available) {
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(Queries[slot], GL_QUERY_RESULT, &elapsed);
+        Onyx::GPUProfiler::AddSample("ImGui Viewports", Starts[slot], elapsed);
+      }
+      Pending[slot] = false;
+    }
+#if ONYX_PROFILE
+    Starts[slot] = Onyx::Profiler::Now();
+#endif
+    glBeginQuery(GL_TIME_ELAPSED, Queries[slot]);
+  }
+
+  void End() {
+    glEndQuery(GL_TIME_ELAPSED);
+    Pending[Next] = true;
+    Next = (Next + 1) % Count;
+  }
+};
+
 static void ImGui_ImplOpenGL3_RenderWindow(ImGuiViewport* viewport, void*) {
+  // Each platform window has its own context, which the state tracker knows nothing about; forget
+  // it again afterwards so the main context starts from scratch too.
+  Onyx::OpenGLState::Invalidate();
+  if (!viewport->RendererUserData) {
+    viewport->RendererUserData = IM_NEW(ImGui_ImplOpenGL3_ViewportTimer)();
+  }
+  ImGui_ImplOpenGL3_ViewportTimer* timer =
+      (ImGui_ImplOpenGL3_ViewportTimer*)viewport->RendererUserData;
+  timer->Begin();
   if (!(viewport->Flags & ImGuiViewportFlags_NoRendererClear)) {
+    Onyx::OpenGLState::SetEnabled(GL_SCISSOR_TEST, false);
     ImVec4 clear_color = ImVec4(0.0f, 0.0f, 0.0f, 1.0f);
     glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
     glClear(GL_COLOR_BUFFER_BIT);
   }
   ImGui_ImplOpenGL3_RenderDrawData(viewport->DrawData);
+  timer->End();
+  Onyx::OpenGLState::Invalidate();
+}
+
+static void ImGui_ImplOpenGL3_DestroyWindow(ImGuiViewport* viewport) {
+  if (viewport->RendererUserData) {
+    IM_DELETE((ImGui_ImplOpenGL3_ViewportTimer*)viewport->RendererUserData);
+    viewport->RendererUserData = NULL;
+  }
 }
 
 static void ImGui_ImplOpenGL3_InitPlatformInterface() {
   ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
   platform_io.Renderer_RenderWindow = ImGui_ImplOpenGL3_RenderWindow;
+  platform_io.Renderer_DestroyWindow = ImGui_ImplOpenGL3_DestroyWindow;
 }
 
 static void ImGui_ImplOpenGL3_ShutdownPlatformInterface() { ImGui::DestroyPlatformWindows(); }
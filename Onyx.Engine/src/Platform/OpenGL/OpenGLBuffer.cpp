@@ -0,0 +1,98 @@
+#include "pch.h"
+
+#include "OpenGLBuffer.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+#include "Onyx/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLState.h"
+#include "Platform/OpenGL/OpenGLStreamBuffer.h"
+
+namespace Onyx {
+// Copies data into frame memory, so the caller's copy may go away before the upload runs.
+static const void* CopyForUpload(const void* data, uint32_t size) {
+  void* copy = Renderer::Allocate(size);
+  std::memcpy(copy, data, size);
+  return copy;
+}
+
+static void DeleteBuffer(OpenGLBufferData* data) {
+  Renderer::Submit([data]() {
+    if (data->Stream) {
+      delete data->Stream;
+    } else {
+      OpenGLState::ForgetBuffer(data->RendererID);
+      glDeleteBuffers(1, &data->RendererID);
+    }
+    delete data;
+  });
+}
+
+OpenGLVertexBuffer::OpenGLVertexBuffer(uint32_t size)
+    : m_Data(new OpenGLBufferData()), m_Size(size) {
+  Renderer::Submit([data = m_Data, size]() {
+    data->Stream = new OpenGLStreamBuffer(size);
+    data->RendererID = data->Stream->GetRendererID();
+  });
+}
+
+OpenGLVertexBuffer::OpenGLVertexBuffer(const float* vertices, uint32_t size)
+    : m_Data(new OpenGLBufferData()), m_Size(size) {
+  const void* copy = CopyForUpload(vertices, size);
+  Renderer::Submit([data = m_Data, copy, size]() {
+    glCreateBuffers(1, &data->RendererID);
+    glNamedBufferData(data->RendererID, size, copy, GL_STATIC_DRAW);
+  });
+}
+
+OpenGLVertexBuffer::~OpenGLVertexBuffer() { DeleteBuffer(m_Data); }
+
+void OpenGLVertexBuffer::Bind() const {
+  Renderer::Submit([data = m_Data]() { OpenGLState::BindBuffer(GL_ARRAY_BUFFER, data->RendererID); });
+}
+
+void OpenGLVertexBuffer::Unbind() const {
+  Renderer::Submit([]() { OpenGLState::BindBuffer(GL_ARRAY_BUFFER, 0); });
+}
+
+uint32_t OpenGLVertexBuffer::Stream(const void* vertices, uint32_t size) {
+  const uint32_t offset =
+      OpenGLStreamBuffer::Reserve(m_StreamHead, m_Size, size, std::max(m_Layout.GetStride(), 1u));
+  Renderer::Submit([data = m_Data, offset, vertices, size]() {
+    OnyxAssert(data->Stream, "Only dynamic vertex buffers can be streamed to!");
+    data->Stream->Write(offset, vertices, size);
+  });
+  return offset;
+}
+
+void OpenGLVertexBuffer::SetData(const void* vertices, uint32_t size) {
+  const void* copy = CopyForUpload(vertices, size);
+  Renderer::Submit([data = m_Data, copy, size]() {
+    glNamedBufferSubData(data->RendererID, 0, size, copy);
+  });
+}
+
+OpenGLIndexBuffer::OpenGLIndexBuffer(const uint32_t* indices, uint32_t count)
+    : m_Data(new OpenGLBufferData()), m_Count(count) {
+  const uint32_t size = count * sizeof(uint32_t);
+  const void* copy = CopyForUpload(indices, size);
+  Renderer::Submit([data = m_Data, copy, size]() {
+    glCreateBuffers(1, &data->RendererID);
+    glNamedBufferData(data->RendererID, size, copy, GL_STATIC_DRAW);
+  });
+}
+
+OpenGLIndexBuffer::~OpenGLIndexBuffer() { DeleteBuffer(m_Data); }
+
+void OpenGLIndexBuffer::Bind() const {
+  Renderer::Submit([data = m_Data]() {
+    OpenGLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, data->RendererID);
+  });
+}
+
+void OpenGLIndexBuffer::Unbind() const {
+  Renderer::Submit([]() { OpenGLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0); });
+}
+}  // namespace Onyx
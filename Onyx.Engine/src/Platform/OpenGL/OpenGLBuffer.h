@@ -0,0 +1,58 @@
+#pragma once
+
+#include "Onyx/Renderer/Buffer.h"
+
+namespace Onyx {
+class OpenGLStreamBuffer;
+
+// GL object names live in a heap block owned by the command stream: they are only known once the
+// render thread has created the buffer, and must outlive this object until its deletion runs.
+struct OpenGLBufferData {
+  uint32_t RendererID = 0;
+  // Backs dynamic vertex buffers.
+  OpenGLStreamBuffer* Stream = nullptr;
+};
+
+class OpenGLVertexBuffer : public VertexBuffer {
+ public:
+  OpenGLVertexBuffer(uint32_t size);
+  OpenGLVertexBuffer(const float* vertices, uint32_t size);
+  ~OpenGLVertexBuffer() override;
+
+  void Bind() const override;
+  void Unbind() const override;
+
+  void SetData(const void* data, uint32_t size) override;
+  uint32_t Stream(const void* data, uint32_t size) override;
+
+  const BufferLayout& GetLayout() const override { return m_Layout; }
+  void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
+
+  // Only to be dereferenced from submitted commands.
+  OpenGLBufferData* GetData() const { return m_Data; }
+
+ private:
+  OpenGLBufferData* m_Data;
+  BufferLayout m_Layout;
+  uint32_t m_Size;
+  uint32_t m_StreamHead = 0;
+};
+
+class OpenGLIndexBuffer : public IndexBuffer {
+ public:
+  OpenGLIndexBuffer(const uint32_t* indices, uint32_t count);
+  ~OpenGLIndexBuffer() override;
+
+  void Bind() const override;
+  void Unbind() const override;
+
+  uint32_t GetCount() const override { return m_Count; }
+
+  // Only to be dereferenced from submitted commands.
+  OpenGLBufferData* GetData() const { return m_Data; }
+
+ private:
+  OpenGLBufferData* m_Data;
+  uint32_t m_Count;
+};
+}  // namespace Onyx
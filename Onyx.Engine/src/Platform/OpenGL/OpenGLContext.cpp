@@ -2,34 +2,43 @@
 
 #include "OpenGLContext.h"
 
+#include <GLFW/glfw3.h>
 #include <glad/glad.h>
 
 #include "Onyx/Core.h"
-
-#ifdef ONYX_PLATFORM_WINDOWS
-#include <GLFW/glfw3.h>
-#endif
+#include "Platform/OpenGL/OpenGLExtensions.h"
+#include "Platform/OpenGL/OpenGLState.h"
 
 namespace Onyx {
 void OpenGLContext::Init() {
   OnyxInfo("Initializing OpenGL renderer...");
 
-#ifdef ONYX_PLATFORM_WINDOWS
   GLFWwindow* window = static_cast<GLFWwindow*>(m_WindowHandle);
   glfwMakeContextCurrent(window);
   int glad = gladLoadGLLoader(reinterpret_cast<GLADloadproc>(glfwGetProcAddress));
   OnyxAssert(glad, "Failed to initialize Glad!");
-#endif
 
-  OnyxInfo("- Vendor: {}", glGetString(GL_VENDOR));
-  OnyxInfo("- Renderer: {}", glGetString(GL_RENDERER));
-  OnyxInfo("- Version: {}", glGetString(GL_VERSION));
+  OnyxInfo("- Vendor: {}", reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+  OnyxInfo("- Renderer: {}", reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+  OnyxInfo("- Version: {}", reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+  if (!GLAD_GL_VERSION_4_5) {
+    OnyxFatal("OpenGL 4.5 is required, the driver only provides {}",
+              reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+  }
+  OnyxAssert(GLAD_GL_VERSION_4_5, "OpenGL 4.5 is required!");
+  OpenGLExtensions::Load(reinterpret_cast<OpenGLExtensions::LoadProc>(glfwGetProcAddress));
+  OpenGLState::Invalidate();
 }
 
 void OpenGLContext::SwapBuffers() {
-#ifdef ONYX_PLATFORM_WINDOWS
   GLFWwindow* window = static_cast<GLFWwindow*>(m_WindowHandle);
   glfwSwapBuffers(window);
-#endif
 }
+
+void OpenGLContext::MakeCurrent() {
+  glfwMakeContextCurrent(static_cast<GLFWwindow*>(m_WindowHandle));
+  OpenGLState::Invalidate();
+}
+
+void OpenGLContext::ReleaseCurrent() { glfwMakeContextCurrent(nullptr); }
 }  // namespace Onyx
\ No newline at end of file
@@ -5,11 +5,13 @@
 namespace Onyx {
 class OpenGLContext : public GraphicsContext {
  public:
-  OpenGLContext::OpenGLContext(void* handle) : m_WindowHandle(handle) {}
+  OpenGLContext(void* handle) : m_WindowHandle(handle) {}
 
   void Init() override;
   void Shutdown() override {}
   void SwapBuffers() override;
+  void MakeCurrent() override;
+  void ReleaseCurrent() override;
 
  private:
   void* m_WindowHandle;
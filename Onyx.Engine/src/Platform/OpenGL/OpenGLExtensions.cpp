@@ -0,0 +1,45 @@
+#include "pch.h"
+
+#include "OpenGLExtensions.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+namespace Onyx {
+using MaxShaderCompilerThreadsProc = void(APIENTRYP)(GLuint count);
+
+static bool s_ParallelShaderCompile = false;
+
+static bool IsExtensionSupported(const char* name) {
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint i = 0; i < count; ++i) {
+    const auto* extension = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+    if (extension && std::strcmp(extension, name) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void OpenGLExtensions::Load(LoadProc load) {
+  // Both versions of the extension share their enums and differ only in the function suffix.
+  MaxShaderCompilerThreadsProc maxShaderCompilerThreads = nullptr;
+  if (IsExtensionSupported("GL_KHR_parallel_shader_compile")) {
+    maxShaderCompilerThreads =
+        reinterpret_cast<MaxShaderCompilerThreadsProc>(load("glMaxShaderCompilerThreadsKHR"));
+  } else if (IsExtensionSupported("GL_ARB_parallel_shader_compile")) {
+    maxShaderCompilerThreads =
+        reinterpret_cast<MaxShaderCompilerThreadsProc>(load("glMaxShaderCompilerThreadsARB"));
+  }
+
+  s_ParallelShaderCompile = maxShaderCompilerThreads != nullptr;
+  if (s_ParallelShaderCompile) {
+    maxShaderCompilerThreads(0xffffffff);  // Driver's choice
+  }
+  OnyxInfo("- Parallel shader compilation: {}", s_ParallelShaderCompile ? "yes" : "no");
+}
+
+bool OpenGLExtensions::HasParallelShaderCompile() { return s_ParallelShaderCompile; }
+}  // namespace Onyx
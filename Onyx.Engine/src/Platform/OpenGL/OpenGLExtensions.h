@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Onyx {
+// Extensions the generated loader does not cover, loaded by the context right after Glad.
+class OpenGLExtensions final {
+ public:
+  using LoadProc = void* (*)(const char* name);
+
+  static void Load(LoadProc load);
+
+  // KHR/ARB_parallel_shader_compile: compiling and linking return immediately and
+  // GL_COMPLETION_STATUS can be polled without blocking. Load() already asks the driver to use
+  // as many compiler threads as it likes.
+  static bool HasParallelShaderCompile();
+};
+}  // namespace Onyx
@@ -0,0 +1,58 @@
+#include "pch.h"
+
+#include "OpenGLRendererAPI.h"
+
+#include <glad/glad.h>
+
+#include "Onyx/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLState.h"
+
+namespace Onyx {
+void OpenGLRendererAPI::Init() {
+  Renderer::Submit([this]() {
+    ApplyDrawState();
+
+    GLint textureUnits = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &textureUnits);
+    m_Capabilities.MaxTextureSlots = static_cast<uint32_t>(std::max(textureUnits, 1));
+  });
+}
+
+void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+  Renderer::Submit([this, x, y, width, height]() {
+    m_Viewport = {x, y, width, height};
+    ApplyDrawState();
+  });
+}
+
+void OpenGLRendererAPI::SetClearColor(const glm::vec4& color) {
+  Renderer::Submit([color]() { glClearColor(color.r, color.g, color.b, color.a); });
+}
+
+void OpenGLRendererAPI::Clear() {
+  Renderer::Submit([this]() {
+    ApplyDrawState();
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  });
+}
+
+void OpenGLRendererAPI::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount,
+                                    uint32_t baseVertex) {
+  const uint32_t count = indexCount ? indexCount : vertexArray->GetIndexBuffer()->GetCount();
+  vertexArray->Bind();
+  Renderer::Submit([this, count, baseVertex]() {
+    ApplyDrawState();
+    glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_INT, nullptr, baseVertex);
+  });
+}
+
+void OpenGLRendererAPI::ApplyDrawState() const {
+  OpenGLState::SetEnabled(GL_BLEND, true);
+  OpenGLState::SetBlendEquation(GL_FUNC_ADD);
+  OpenGLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  OpenGLState::SetEnabled(GL_SCISSOR_TEST, false);
+  if (m_Viewport[2] > 0 && m_Viewport[3] > 0) {
+    OpenGLState::SetViewport(m_Viewport[0], m_Viewport[1], m_Viewport[2], m_Viewport[3]);
+  }
+}
+}  // namespace Onyx
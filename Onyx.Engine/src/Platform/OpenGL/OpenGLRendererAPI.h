@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+
+#include "Onyx/Renderer/RendererAPI.h"
+
+namespace Onyx {
+class OpenGLRendererAPI : public RendererAPI {
+ public:
+  void Init() override;
+  void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+  void SetClearColor(const glm::vec4& color) override;
+  void Clear() override;
+
+  void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0,
+                   uint32_t baseVertex = 0) override;
+
+  const RendererCapabilities& GetCapabilities() const override { return m_Capabilities; }
+
+ private:
+  // Other code sharing the context, such as the ImGui backend, leaves its own state behind, so
+  // the state engine draws rely on is reapplied before every clear and draw. OpenGLState keeps
+  // that from reaching the driver unless something actually changed. Render thread only.
+  void ApplyDrawState() const;
+
+  RendererCapabilities m_Capabilities;
+  std::array<uint32_t, 4> m_Viewport = {};  // Render thread only; empty until first set
+};
+}  // namespace Onyx
@@ -0,0 +1,441 @@
+#include "pch.h"
+
+#include "OpenGLShader.h"
+
+#include <glad/glad.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "Onyx/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLExtensions.h"
+#include "Platform/OpenGL/OpenGLState.h"
+
+// From KHR_parallel_shader_compile, which Glad was not generated with.
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+
+namespace Onyx {
+using ShaderClock = std::chrono::steady_clock;
+using UniformSetter = std::function<void(GLuint program, GLint location)>;
+
+// Marks a fallback uniform location that has not been looked up yet.
+static constexpr GLint UnresolvedLocation = -2;
+
+// A program whose compile and link were started but not yet checked, or that failed to link.
+struct PendingProgram {
+  std::string Name;
+  std::string CachePath;
+  GLuint Vertex = 0;
+  GLuint Fragment = 0;
+  ShaderClock::time_point Start;
+  // The link failed, the fallback program stands in for good.
+  bool Failed = false;
+
+  // Latest value of every uniform set meanwhile, by uniform index. Applied once the program is
+  // linked, and to the fallback program while it stands in.
+  std::vector<UniformSetter> Uniforms;
+  std::vector<GLint> FallbackLocations;
+};
+
+struct OpenGLShaderData {
+  uint32_t RendererID = 0;
+  std::vector<std::string> UniformNames;
+  std::vector<GLint> UniformLocations;
+  Scope<PendingProgram> Pending;  // Null once the program is usable
+};
+
+// Program binaries are stored as this header followed by the driver's blob.
+struct ProgramBinaryHeader {
+  static constexpr uint32_t ExpectedMagic = 0x4258534f;  // "OSXB"
+
+  uint32_t Magic = ExpectedMagic;
+  uint32_t Format = 0;
+  uint32_t Size = 0;
+};
+
+static uint32_t s_ShaderCount = 0;
+static GLuint s_FallbackProgram = 0;
+
+// Stands in for programs that are still compiling. Engine shaders take their position from
+// attribute 0 and u_ViewProjection, which is all the fallback needs to draw the same geometry.
+static const char* s_FallbackVertexSource = R"(
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+
+uniform mat4 u_ViewProjection;
+
+void main() {
+  gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+)";
+
+static const char* s_FallbackFragmentSource = R"(
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+
+void main() {
+  o_Color = vec4(1.0, 0.0, 1.0, 0.5);
+}
+)";
+
+static float GetElapsedMs(ShaderClock::time_point start) {
+  return std::chrono::duration<float, std::milli>(ShaderClock::now() - start).count();
+}
+
+static GLuint CompileShader(GLenum type, const std::string& source) {
+  GLuint shader = glCreateShader(type);
+  const GLchar* src = source.c_str();
+  glShaderSource(shader, 1, &src, nullptr);
+  glCompileShader(shader);
+  return shader;
+}
+
+static void LogCompileErrors(GLuint shader, const std::string& name, const char* stage) {
+  GLint compiled = GL_FALSE;
+  glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+  if (compiled == GL_FALSE) {
+    GLint length = 0;
+    glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+    std::vector<GLchar> log(std::max(length, 1));
+    glGetShaderInfoLog(shader, length, &length, log.data());
+    OnyxError("Failed to compile {} shader of '{}':\n{}", stage, name, log.data());
+  }
+}
+
+// FNV-1a, which unlike std::hash is guaranteed to give the same key on every run.
+static uint64_t HashString(const std::string& text, uint64_t hash = 14695981039346656037ull) {
+  for (const char c : text) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  return hash;
+}
+
+// Binaries are only valid for the driver that produced them, so the driver is part of the key.
+// Returns an empty path when caching is disabled or the driver can't save binaries.
+static std::string GetProgramCachePath(const std::string& name, const std::string& vertexSrc,
+                                       const std::string& fragmentSrc) {
+  const std::string& directory = Shader::GetCacheDirectory();
+  static const bool s_Supported = []() {
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+  }();
+  if (directory.empty() || !s_Supported) {
+    return {};
+  }
+
+  static const uint64_t s_DriverHash = []() {
+    uint64_t hash = HashString(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hash = HashString(reinterpret_cast<const char*>(glGetString(GL_RENDERER)), hash);
+    return HashString(reinterpret_cast<const char*>(glGetString(GL_VERSION)), hash);
+  }();
+  const uint64_t hash = HashString(fragmentSrc, HashString(vertexSrc, s_DriverHash));
+
+  char key[17];
+  std::snprintf(key, sizeof(key), "%016llx", static_cast<unsigned long long>(hash));
+  return directory + "/" + name + "-" + key + ".bin";
+}
+
+static bool LoadProgramBinary(GLuint program, const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  const std::streamoff fileSize = file.tellg();
+  file.seekg(0);
+  ProgramBinaryHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      header.Magic != ProgramBinaryHeader::ExpectedMagic) {
+    return false;
+  }
+
+  // A truncated or corrupt file must not make us allocate whatever size it claims.
+  const std::streamoff remaining = fileSize - static_cast<std::streamoff>(sizeof(header));
+  if (header.Size == 0 || header.Size > remaining) {
+    OnyxWarn("Ignoring corrupt shader cache '{}'", path);
+    return false;
+  }
+
+  std::vector<char> binary(header.Size);
+  if (!file.read(binary.data(), header.Size)) {
+    return false;
+  }
+
+  glProgramBinary(program, header.Format, binary.data(), header.Size);
+  GLint linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  return linked == GL_TRUE;
+}
+
+static void SaveProgramBinary(GLuint program, const std::string& path) {
+  GLint size = 0;
+  glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+  if (size <= 0) {
+    return;
+  }
+
+  ProgramBinaryHeader header;
+  std::vector<char> binary(size);
+  glGetProgramBinary(program, size, nullptr, &header.Format, binary.data());
+  header.Size = static_cast<uint32_t>(size);
+
+  std::error_code error;
+  std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+  std::ofstream file(path, std::ios::binary);
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(binary.data(), size);
+  if (!file) {
+    OnyxWarn("Failed to write shader cache '{}'", path);
+  }
+}
+
+// Loads the program from the cache, or starts compiling and linking it without waiting for
+// either. Returns the program and, if it isn't usable yet, what is needed to finish it.
+static GLuint BeginProgram(const std::string& name, const std::string& vertexSrc,
+                           const std::string& fragmentSrc, Scope<PendingProgram>& pending) {
+  const ShaderClock::time_point start = ShaderClock::now();
+  const std::string cachePath = GetProgramCachePath(name, vertexSrc, fragmentSrc);
+  if (!cachePath.empty()) {
+    GLuint program = glCreateProgram();
+    if (LoadProgramBinary(program, cachePath)) {
+      OnyxInfo("Shader '{}' loaded from cache in {:.2f} ms", name, GetElapsedMs(start));
+      return program;
+    }
+    // Missing, or rejected because the driver changed in a way its strings don't show.
+    glDeleteProgram(program);
+  }
+
+  pending = CreateScope<PendingProgram>();
+  pending->Name = name;
+  pending->CachePath = cachePath;
+  pending->Start = start;
+  pending->Vertex = CompileShader(GL_VERTEX_SHADER, vertexSrc);
+  pending->Fragment = CompileShader(GL_FRAGMENT_SHADER, fragmentSrc);
+
+  GLuint program = glCreateProgram();
+  if (!cachePath.empty()) {
+    glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
+  glAttachShader(program, pending->Vertex);
+  glAttachShader(program, pending->Fragment);
+  glLinkProgram(program);
+  return program;
+}
+
+// Whether checking the program's link status would not block.
+static bool IsProgramComplete(GLuint program) {
+  if (!OpenGLExtensions::HasParallelShaderCompile()) {
+    return true;
+  }
+  GLint complete = GL_FALSE;
+  glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &complete);
+  return complete == GL_TRUE;
+}
+
+// Returns whether the program linked.
+static bool FinishProgram(GLuint program, const PendingProgram& pending) {
+  GLint linked = GL_FALSE;
+  glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  if (linked == GL_FALSE) {
+    LogCompileErrors(pending.Vertex, pending.Name, "vertex");
+    LogCompileErrors(pending.Fragment, pending.Name, "fragment");
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &length);
+    std::vector<GLchar> log(std::max(length, 1));
+    glGetProgramInfoLog(program, length, &length, log.data());
+    OnyxError("Failed to link shader '{}':\n{}", pending.Name, log.data());
+  }
+
+  glDetachShader(program, pending.Vertex);
+  glDetachShader(program, pending.Fragment);
+  glDeleteShader(pending.Vertex);
+  glDeleteShader(pending.Fragment);
+
+  if (linked == GL_FALSE) {
+    return false;
+  }
+  if (!pending.CachePath.empty()) {
+    SaveProgramBinary(program, pending.CachePath);
+  }
+  OnyxInfo("Shader '{}' compiled from source in {:.2f} ms", pending.Name,
+           GetElapsedMs(pending.Start));
+  return true;
+}
+
+uint32_t OpenGLShader::LinkProgram(const std::string& name, const std::string& vertexSrc,
+                                   const std::string& fragmentSrc) {
+  Scope<PendingProgram> pending;
+  const GLuint program = BeginProgram(name, vertexSrc, fragmentSrc, pending);
+  if (pending) {
+    FinishProgram(program, *pending);
+  }
+  return program;
+}
+
+// Finishes the program if the driver is done with it. Returns whether it is usable.
+static bool UpdatePending(OpenGLShaderData* data) {
+  if (!data->Pending) {
+    return true;
+  }
+  if (data->Pending->Failed || !IsProgramComplete(data->RendererID)) {
+    return false;
+  }
+
+  if (!FinishProgram(data->RendererID, *data->Pending)) {
+    data->Pending->Failed = true;
+    return false;
+  }
+  for (size_t i = 0; i < data->UniformNames.size(); ++i) {
+    data->UniformLocations[i] =
+        glGetUniformLocation(data->RendererID, data->UniformNames[i].c_str());
+  }
+  const std::vector<UniformSetter>& uniforms = data->Pending->Uniforms;
+  for (size_t i = 0; i < uniforms.size(); ++i) {
+    if (uniforms[i]) {
+      uniforms[i](data->RendererID, data->UniformLocations[i]);
+    }
+  }
+  data->Pending.reset();
+  return true;
+}
+
+// Binds the fallback program in place of a pending one, with the uniforms the two share.
+static void BindFallback(OpenGLShaderData* data) {
+  if (!s_FallbackProgram) {
+    s_FallbackProgram = static_cast<GLuint>(OpenGLShader::LinkProgram(
+        "Fallback", s_FallbackVertexSource, s_FallbackFragmentSource));
+  }
+  OpenGLState::UseProgram(s_FallbackProgram);
+
+  PendingProgram& pending = *data->Pending;
+  pending.FallbackLocations.resize(pending.Uniforms.size(), UnresolvedLocation);
+  for (size_t i = 0; i < pending.Uniforms.size(); ++i) {
+    if (!pending.Uniforms[i]) {
+      continue;
+    }
+    GLint& location = pending.FallbackLocations[i];
+    if (location == UnresolvedLocation) {
+      location = glGetUniformLocation(s_FallbackProgram, data->UniformNames[i].c_str());
+    }
+    if (location >= 0) {
+      pending.Uniforms[i](s_FallbackProgram, location);
+    }
+  }
+}
+
+// Sets a uniform right away, or remembers it until the program has linked, since touching the
+// program before then would wait for the compiler.
+template <typename F>
+static void SetUniform(OpenGLShaderData* data, uint32_t index, F&& set) {
+  if (!data->Pending) {
+    set(data->RendererID, data->UniformLocations[index]);
+    return;
+  }
+
+  std::vector<UniformSetter>& uniforms = data->Pending->Uniforms;
+  if (uniforms.size() <= index) {
+    uniforms.resize(index + 1);
+  }
+  uniforms[index] = std::forward<F>(set);
+}
+
+OpenGLShader::OpenGLShader(const std::string& name, const std::string& vertexSrc,
+                           const std::string& fragmentSrc)
+    : m_Data(new OpenGLShaderData()), m_Name(name) {
+  Renderer::Submit([data = m_Data, name, vertexSrc, fragmentSrc]() {
+    s_ShaderCount++;
+    data->RendererID = BeginProgram(name, vertexSrc, fragmentSrc, data->Pending);
+  });
+}
+
+OpenGLShader::~OpenGLShader() {
+  Renderer::Submit([data = m_Data]() {
+    if (data->Pending) {
+      glDeleteShader(data->Pending->Vertex);
+      glDeleteShader(data->Pending->Fragment);
+    }
+    OpenGLState::ForgetProgram(data->RendererID);
+    glDeleteProgram(data->RendererID);
+    delete data;
+
+    if (--s_ShaderCount == 0 && s_FallbackProgram) {
+      OpenGLState::ForgetProgram(s_FallbackProgram);
+      glDeleteProgram(s_FallbackProgram);
+      s_FallbackProgram = 0;
+    }
+  });
+}
+
+void OpenGLShader::Bind() const {
+  Renderer::Submit([data = m_Data]() {
+    if (UpdatePending(data)) {
+      OpenGLState::UseProgram(data->RendererID);
+    } else {
+      BindFallback(data);
+    }
+  });
+}
+
+void OpenGLShader::Unbind() const {
+  Renderer::Submit([]() { OpenGLState::UseProgram(0); });
+}
+
+void OpenGLShader::SetInt(const std::string& name, int value) {
+  Renderer::Submit([data = m_Data, index = GetUniformIndex(name), value]() {
+    SetUniform(data, index, [value](GLuint program, GLint location) {
+      glProgramUniform1i(program, location, value);
+    });
+  });
+}
+
+void OpenGLShader::SetIntArray(const std::string& name, const int* values, uint32_t count) {
+  // Owned by the command rather than frame memory, it may have to outlive the frame.
+  std::vector<int> copy(values, values + count);
+  Renderer::Submit([data = m_Data, index = GetUniformIndex(name), copy = std::move(copy)]() {
+    SetUniform(data, index, [copy](GLuint program, GLint location) {
+      glProgramUniform1iv(program, location, static_cast<GLsizei>(copy.size()), copy.data());
+    });
+  });
+}
+
+void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value) {
+  Renderer::Submit([data = m_Data, index = GetUniformIndex(name), value]() {
+    SetUniform(data, index, [value](GLuint program, GLint location) {
+      glProgramUniform4f(program, location, value.x, value.y, value.z, value.w);
+    });
+  });
+}
+
+void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value) {
+  Renderer::Submit([data = m_Data, index = GetUniformIndex(name), value]() {
+    SetUniform(data, index, [value](GLuint program, GLint location) {
+      glProgramUniformMatrix4fv(program, location, 1, GL_FALSE, &value[0][0]);
+    });
+  });
+}
+
+uint32_t OpenGLShader::GetUniformIndex(const std::string& name) {
+  auto it = m_UniformIndices.find(name);
+  if (it != m_UniformIndices.end()) {
+    return it->second;
+  }
+
+  const auto index = static_cast<uint32_t>(m_UniformIndices.size());
+  m_UniformIndices.emplace(name, index);
+  Renderer::Submit([data = m_Data, index, name]() {
+    data->UniformNames.resize(index + 1);
+    data->UniformNames[index] = name;
+    data->UniformLocations.resize(index + 1, -1);
+    // A pending program looks its uniforms up once linked.
+    if (!data->Pending) {
+      data->UniformLocations[index] = glGetUniformLocation(data->RendererID, name.c_str());
+    }
+  });
+  return index;
+}
+}  // namespace Onyx
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+
+#include "Onyx/Renderer/Shader.h"
+
+namespace Onyx {
+struct OpenGLShaderData;
+
+// Creating a shader only starts compiling it; with parallel shader compilation the driver does
+// so in the background. Until the program has linked, Bind() uses a fallback program that draws
+// the same geometry in a flat color, and uniforms are held back and applied once it is ready. A
+// program that fails to link keeps drawing with the fallback.
+class OpenGLShader : public Shader {
+ public:
+  OpenGLShader(const std::string& name, const std::string& vertexSrc,
+               const std::string& fragmentSrc);
+  ~OpenGLShader() override;
+
+  void Bind() const override;
+  void Unbind() const override;
+
+  void SetInt(const std::string& name, int value) override;
+  void SetIntArray(const std::string& name, const int* values, uint32_t count) override;
+  void SetFloat4(const std::string& name, const glm::vec4& value) override;
+  void SetMat4(const std::string& name, const glm::mat4& value) override;
+
+  const std::string& GetName() const override { return m_Name; }
+
+  // Compiles and links a program, waiting for the result, or loads it from the binary cache when
+  // an identical one was linked by the same driver before. Render thread only.
+  static uint32_t LinkProgram(const std::string& name, const std::string& vertexSrc,
+                              const std::string& fragmentSrc);
+
+ private:
+  // Uniform locations are looked up on the render thread. The main thread only hands out an
+  // index per name, so setting a known uniform never has to copy its name.
+  uint32_t GetUniformIndex(const std::string& name);
+
+  OpenGLShaderData* m_Data;
+  std::string m_Name;
+  std::unordered_map<std::string, uint32_t> m_UniformIndices;
+};
+}  // namespace Onyx
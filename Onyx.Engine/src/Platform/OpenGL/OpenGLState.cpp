@@ -0,0 +1,192 @@
+#include "pch.h"
+
+#include "OpenGLState.h"
+
+#include <glad/glad.h>
+
+#include <array>
+
+namespace Onyx {
+// Marks a shadowed value that does not match anything GL could hold.
+static constexpr uint32_t Unknown = ~0u;
+
+// Capabilities with a shadow; anything else is passed straight through.
+static constexpr std::array<GLenum, 5> s_Capabilities = {GL_BLEND, GL_CULL_FACE, GL_DEPTH_TEST,
+                                                         GL_SCISSOR_TEST, GL_STENCIL_TEST};
+
+// Starts out knowing nothing, which is also what Invalidate() returns to.
+struct OpenGLStateData {
+  static constexpr uint32_t MaxTextureUnits = 32;
+
+  uint32_t Program = Unknown;
+  uint32_t VertexArray = Unknown;
+  uint32_t ArrayBuffer = Unknown;
+  uint32_t ElementArrayBuffer = Unknown;
+  std::array<uint32_t, MaxTextureUnits> Textures;
+  std::array<uint32_t, MaxTextureUnits> Samplers;
+
+  std::array<uint32_t, s_Capabilities.size()> Enabled;  // 0, 1 or Unknown
+  uint32_t BlendEquation = Unknown;
+  uint32_t BlendSource = Unknown;
+  uint32_t BlendDestination = Unknown;
+  uint32_t PolygonMode = Unknown;
+  std::array<int32_t, 4> Viewport = {};
+  std::array<int32_t, 4> Scissor = {};
+  bool ViewportKnown = false;
+  bool ScissorKnown = false;
+
+  OpenGLStateData() {
+    Textures.fill(Unknown);
+    Samplers.fill(Unknown);
+    Enabled.fill(Unknown);
+  }
+};
+
+static OpenGLStateData s_State;
+
+static uint32_t* FindCapability(GLenum capability) {
+  for (size_t i = 0; i < s_Capabilities.size(); ++i) {
+    if (s_Capabilities[i] == capability) {
+      return &s_State.Enabled[i];
+    }
+  }
+  return nullptr;
+}
+
+void OpenGLState::Invalidate() { s_State = OpenGLStateData(); }
+
+void OpenGLState::UseProgram(uint32_t program) {
+  if (s_State.Program != program) {
+    glUseProgram(program);
+    s_State.Program = program;
+  }
+}
+
+void OpenGLState::BindVertexArray(uint32_t vertexArray) {
+  if (s_State.VertexArray != vertexArray) {
+    glBindVertexArray(vertexArray);
+    s_State.VertexArray = vertexArray;
+    s_State.ElementArrayBuffer = Unknown;
+  }
+}
+
+void OpenGLState::BindBuffer(uint32_t target, uint32_t buffer) {
+  uint32_t* shadow = nullptr;
+  if (target == GL_ARRAY_BUFFER) {
+    shadow = &s_State.ArrayBuffer;
+  } else if (target == GL_ELEMENT_ARRAY_BUFFER) {
+    shadow = &s_State.ElementArrayBuffer;
+  }
+
+  if (!shadow || *shadow != buffer) {
+    glBindBuffer(target, buffer);
+    if (shadow) {
+      *shadow = buffer;
+    }
+  }
+}
+
+void OpenGLState::BindTextureUnit(uint32_t unit, uint32_t texture) {
+  if (unit >= OpenGLStateData::MaxTextureUnits) {
+    glBindTextureUnit(unit, texture);
+  } else if (s_State.Textures[unit] != texture) {
+    glBindTextureUnit(unit, texture);
+    s_State.Textures[unit] = texture;
+  }
+}
+
+void OpenGLState::BindSampler(uint32_t unit, uint32_t sampler) {
+  if (unit >= OpenGLStateData::MaxTextureUnits) {
+    glBindSampler(unit, sampler);
+  } else if (s_State.Samplers[unit] != sampler) {
+    glBindSampler(unit, sampler);
+    s_State.Samplers[unit] = sampler;
+  }
+}
+
+void OpenGLState::SetEnabled(uint32_t capability, bool enabled) {
+  uint32_t* shadow = FindCapability(capability);
+  if (shadow && *shadow == static_cast<uint32_t>(enabled)) {
+    return;
+  }
+
+  if (enabled) {
+    glEnable(capability);
+  } else {
+    glDisable(capability);
+  }
+  if (shadow) {
+    *shadow = enabled;
+  }
+}
+
+void OpenGLState::SetBlendEquation(uint32_t mode) {
+  if (s_State.BlendEquation != mode) {
+    glBlendEquation(mode);
+    s_State.BlendEquation = mode;
+  }
+}
+
+void OpenGLState::SetBlendFunc(uint32_t source, uint32_t destination) {
+  if (s_State.BlendSource != source || s_State.BlendDestination != destination) {
+    glBlendFunc(source, destination);
+    s_State.BlendSource = source;
+    s_State.BlendDestination = destination;
+  }
+}
+
+void OpenGLState::SetPolygonMode(uint32_t mode) {
+  if (s_State.PolygonMode != mode) {
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+    s_State.PolygonMode = mode;
+  }
+}
+
+void OpenGLState::SetViewport(int32_t x, int32_t y, int32_t width, int32_t height) {
+  const std::array<int32_t, 4> viewport = {x, y, width, height};
+  if (!s_State.ViewportKnown || s_State.Viewport != viewport) {
+    glViewport(x, y, width, height);
+    s_State.Viewport = viewport;
+    s_State.ViewportKnown = true;
+  }
+}
+
+void OpenGLState::SetScissor(int32_t x, int32_t y, int32_t width, int32_t height) {
+  const std::array<int32_t, 4> scissor = {x, y, width, height};
+  if (!s_State.ScissorKnown || s_State.Scissor != scissor) {
+    glScissor(x, y, width, height);
+    s_State.Scissor = scissor;
+    s_State.ScissorKnown = true;
+  }
+}
+
+void OpenGLState::ForgetProgram(uint32_t program) {
+  if (s_State.Program == program) {
+    s_State.Program = Unknown;
+  }
+}
+
+void OpenGLState::ForgetVertexArray(uint32_t vertexArray) {
+  if (s_State.VertexArray == vertexArray) {
+    s_State.VertexArray = Unknown;
+    s_State.ElementArrayBuffer = Unknown;
+  }
+}
+
+void OpenGLState::ForgetBuffer(uint32_t buffer) {
+  if (s_State.ArrayBuffer == buffer) {
+    s_State.ArrayBuffer = Unknown;
+  }
+  if (s_State.ElementArrayBuffer == buffer) {
+    s_State.ElementArrayBuffer = Unknown;
+  }
+}
+
+void OpenGLState::ForgetTexture(uint32_t texture) {
+  for (uint32_t& bound : s_State.Textures) {
+    if (bound == texture) {
+      bound = Unknown;
+    }
+  }
+}
+}  // namespace Onyx
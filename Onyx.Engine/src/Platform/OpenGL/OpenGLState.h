@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Onyx {
+// Shadows the GL state the engine and the ImGui backend change, so redundant binds and enables
+// never reach the driver and nothing has to be read back with glGet. Like every other GL call it
+// may only be used on the render thread.
+//
+// The shadow describes one context. Invalidate() whenever another context becomes current, after
+// which the next call of each kind goes through unconditionally. Deleted objects have to be
+// forgotten, since GL unbinds them and may hand their name out again.
+class OpenGLState final {
+ public:
+  static void Invalidate();
+
+  static void UseProgram(uint32_t program);
+  // Also forgets the element array buffer, which is part of the vertex array.
+  static void BindVertexArray(uint32_t vertexArray);
+  static void BindBuffer(uint32_t target, uint32_t buffer);
+  static void BindTextureUnit(uint32_t unit, uint32_t texture);
+  static void BindSampler(uint32_t unit, uint32_t sampler);
+
+  static void SetEnabled(uint32_t capability, bool enabled);
+  static void SetBlendEquation(uint32_t mode);
+  static void SetBlendFunc(uint32_t source, uint32_t destination);
+  static void SetPolygonMode(uint32_t mode);
+  static void SetViewport(int32_t x, int32_t y, int32_t width, int32_t height);
+  static void SetScissor(int32_t x, int32_t y, int32_t width, int32_t height);
+
+  static void ForgetProgram(uint32_t program);
+  static void ForgetVertexArray(uint32_t vertexArray);
+  static void ForgetBuffer(uint32_t buffer);
+  static void ForgetTexture(uint32_t texture);
+};
+}  // namespace Onyx
@@ -0,0 +1,118 @@
+#include "pch.h"
+
+#include "OpenGLStreamBuffer.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+#include "Onyx/Debug/Profiler.h"
+#include "Platform/OpenGL/OpenGLState.h"
+
+namespace Onyx {
+OpenGLStreamBuffer::OpenGLStreamBuffer(uint32_t size)
+    : m_Size(size), m_ChunkSize((size + ChunkCount - 1) / ChunkCount) {
+  glCreateBuffers(1, &m_RendererID);
+
+  if (GLAD_GL_VERSION_4_4) {
+    // Dynamic storage keeps glNamedBufferSubData legal for callers that update it directly.
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glNamedBufferStorage(m_RendererID, size, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+    m_Mapped = static_cast<unsigned char*>(glMapNamedBufferRange(m_RendererID, 0, size, flags));
+  }
+
+  if (!m_Mapped) {
+    glNamedBufferData(m_RendererID, size, nullptr, GL_STREAM_DRAW);
+  }
+}
+
+OpenGLStreamBuffer::~OpenGLStreamBuffer() {
+  for (void*& fence : m_Fences) {
+    if (fence) {
+      glDeleteSync(static_cast<GLsync>(fence));
+    }
+  }
+  if (m_Mapped) {
+    glUnmapNamedBuffer(m_RendererID);
+  }
+  OpenGLState::ForgetBuffer(m_RendererID);
+  glDeleteBuffers(1, &m_RendererID);
+}
+
+uint32_t OpenGLStreamBuffer::Reserve(uint32_t& head, uint32_t bufferSize, uint32_t size,
+                                     uint32_t alignment) {
+  OnyxAssert(size <= bufferSize / 2, "Stream buffer write of {} bytes is too large!", size);
+
+  uint32_t offset = (head + alignment - 1) / alignment * alignment;
+  if (offset + size > bufferSize) {
+    offset = 0;
+  }
+  head = offset + size;
+  return offset;
+}
+
+void OpenGLStreamBuffer::Write(uint32_t offset, const void* data, uint32_t size) {
+  if (size == 0) {
+    return;
+  }
+  if (!m_Mapped) {
+    glNamedBufferSubData(m_RendererID, offset, size, data);
+    return;
+  }
+
+  const uint32_t first = offset / m_ChunkSize;
+  const uint32_t last = (offset + size - 1) / m_ChunkSize;
+  const bool wrapped = offset < m_LastEnd;
+  // The chunk the previous write ended in, if writing carries on in it.
+  const uint32_t current = !wrapped && m_LastEnd > 0 ? (m_LastEnd - 1) / m_ChunkSize : ChunkCount;
+  m_LastEnd = offset + size;
+
+  // Everything already submitted from chunks we are leaving gets fenced. After a wrap that
+  // includes the chunks being written again, so the wait below covers them.
+  for (uint32_t chunk = 0; chunk < ChunkCount; ++chunk) {
+    const bool inRange = chunk >= first && chunk <= last;
+    if (m_Dirty[chunk] && (wrapped || !inRange)) {
+      m_Fences[chunk] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      m_Dirty[chunk] = false;
+    }
+  }
+
+  for (uint32_t chunk = first; chunk <= last; ++chunk) {
+    if (GLsync fence = static_cast<GLsync>(m_Fences[chunk])) {
+      // A fence on the chunk still being filled can only come from Fence(). The GPU never reads
+      // past the previous write, and the chunk is fenced again once writing leaves it.
+      if (chunk != current) {
+        ONYX_PROFILE_SCOPE("OpenGLStreamBuffer::Wait");
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        while (result == GL_TIMEOUT_EXPIRED) {
+          result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        }
+      }
+      glDeleteSync(fence);
+      m_Fences[chunk] = nullptr;
+    }
+    m_Dirty[chunk] = true;
+  }
+
+  std::memcpy(m_Mapped + offset, data, size);
+}
+
+void OpenGLStreamBuffer::Fence() {
+  for (uint32_t chunk = 0; chunk < ChunkCount; ++chunk) {
+    if (m_Dirty[chunk]) {
+      m_Fences[chunk] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      m_Dirty[chunk] = false;
+    }
+  }
+}
+
+uint32_t OpenGLStreamBuffer::Push(const void* data, uint32_t size, uint32_t alignment) {
+  const uint32_t offset = Allocate(size, alignment);
+  Write(offset, data, size);
+  return offset;
+}
+
+uint32_t OpenGLStreamBuffer::Allocate(uint32_t size, uint32_t alignment) {
+  return Reserve(m_Head, m_Size, size, alignment);
+}
+}  // namespace Onyx
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Onyx {
+// A buffer that is rewritten every frame, used as a ring. When the driver supports it (GL 4.4),
+// the storage is persistently mapped and written with a plain memcpy; the ring is split into
+// chunks that are fenced once writing moves on, so the CPU only ever waits for the GPU when it
+// catches up with a chunk that is still being read. Without persistent mapping every write is a
+// glNamedBufferSubData.
+//
+// The object itself lives on the render thread. Offsets are handed out by Reserve(), which is pure
+// arithmetic, so the main thread can track its own head and know where its data will land.
+class OpenGLStreamBuffer final {
+ public:
+  static constexpr uint32_t ChunkCount = 4;
+
+  OpenGLStreamBuffer(uint32_t size);
+  ~OpenGLStreamBuffer();
+
+  OpenGLStreamBuffer(const OpenGLStreamBuffer&) = delete;
+  OpenGLStreamBuffer& operator=(const OpenGLStreamBuffer&) = delete;
+
+  // Advances head past size bytes aligned to alignment, wrapping to the start of a buffer of
+  // bufferSize bytes when they don't fit, and returns their offset.
+  static uint32_t Reserve(uint32_t& head, uint32_t bufferSize, uint32_t size, uint32_t alignment);
+
+  // Copies size bytes to offset, first waiting for the GPU if it may still read that range.
+  // Writes must follow the order in which their offsets were reserved.
+  void Write(uint32_t offset, const void* data, uint32_t size);
+
+  // Reserves space at this buffer's own head and writes data there, for callers that already run
+  // on the render thread.
+  uint32_t Push(const void* data, uint32_t size, uint32_t alignment = 4);
+  // Reserves space at this buffer's own head without writing it, so a caller can fill one
+  // contiguous range from several sources with consecutive Write() calls.
+  uint32_t Allocate(uint32_t size, uint32_t alignment = 4);
+
+  // Fences every chunk written since its last fence. Write() only fences a chunk once it moves
+  // on, so callers that write all their data before drawing from it call this after the draws;
+  // otherwise the fence would not cover them.
+  void Fence();
+
+  uint32_t GetRendererID() const { return m_RendererID; }
+  uint32_t GetSize() const { return m_Size; }
+  bool IsPersistent() const { return m_Mapped != nullptr; }
+
+ private:
+  uint32_t m_RendererID = 0;
+  uint32_t m_Size;
+  uint32_t m_ChunkSize;
+  uint32_t m_Head = 0;
+  uint32_t m_LastEnd = 0;
+  unsigned char* m_Mapped = nullptr;
+  void* m_Fences[ChunkCount] = {};
+  bool m_Dirty[ChunkCount] = {};
+};
+}  // namespace Onyx
@@ -0,0 +1,48 @@
+#include "pch.h"
+
+#include "OpenGLTexture.h"
+
+#include <glad/glad.h>
+
+#include <cstring>
+
+#include "Onyx/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLState.h"
+
+namespace Onyx {
+OpenGLTexture2D::OpenGLTexture2D(uint32_t width, uint32_t height)
+    : m_Data(new OpenGLTextureData()), m_Width(width), m_Height(height) {
+  Renderer::Submit([data = m_Data, width, height]() {
+    glCreateTextures(GL_TEXTURE_2D, 1, &data->RendererID);
+    glTextureStorage2D(data->RendererID, 1, GL_RGBA8, width, height);
+
+    glTextureParameteri(data->RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTextureParameteri(data->RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTextureParameteri(data->RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTextureParameteri(data->RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+  });
+}
+
+OpenGLTexture2D::~OpenGLTexture2D() {
+  Renderer::Submit([data = m_Data]() {
+    OpenGLState::ForgetTexture(data->RendererID);
+    glDeleteTextures(1, &data->RendererID);
+    delete data;
+  });
+}
+
+void OpenGLTexture2D::SetData(const void* pixels, uint32_t size) {
+  OnyxAssert(size == m_Width * m_Height * 4, "Texture data must cover the entire texture!");
+
+  void* copy = Renderer::Allocate(size);
+  std::memcpy(copy, pixels, size);
+  Renderer::Submit([data = m_Data, width = m_Width, height = m_Height, copy]() {
+    glTextureSubImage2D(data->RendererID, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, copy);
+  });
+}
+
+void OpenGLTexture2D::Bind(uint32_t slot) const {
+  Renderer::Submit(
+      [data = m_Data, slot]() { OpenGLState::BindTextureUnit(slot, data->RendererID); });
+}
+}  // namespace Onyx
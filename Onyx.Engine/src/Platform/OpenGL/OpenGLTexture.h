@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Onyx/Renderer/Texture.h"
+
+namespace Onyx {
+struct OpenGLTextureData {
+  uint32_t RendererID = 0;
+};
+
+class OpenGLTexture2D : public Texture2D {
+ public:
+  OpenGLTexture2D(uint32_t width, uint32_t height);
+  ~OpenGLTexture2D() override;
+
+  uint32_t GetWidth() const override { return m_Width; }
+  uint32_t GetHeight() const override { return m_Height; }
+
+  void SetData(const void* data, uint32_t size) override;
+
+  void Bind(uint32_t slot = 0) const override;
+
+ private:
+  OpenGLTextureData* m_Data;
+  uint32_t m_Width;
+  uint32_t m_Height;
+};
+}  // namespace Onyx
@@ -0,0 +1,48 @@
+#include "pch.h"
+
+#include "OpenGLTimerQueryPool.h"
+
+#include <glad/glad.h>
+
+namespace Onyx {
+OpenGLTimerQueryPool::OpenGLTimerQueryPool(uint32_t capacity) {
+  // Timer queries are core, but a driver may still report a counter without any bits.
+  GLint bits = 0;
+  glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+  if (bits == 0) {
+    OnyxWarn("GPU timestamps are not supported, GPU timings will be unavailable");
+    return;
+  }
+
+  m_Queries.resize(capacity);
+  glCreateQueries(GL_TIMESTAMP, static_cast<GLsizei>(capacity), m_Queries.data());
+}
+
+OpenGLTimerQueryPool::~OpenGLTimerQueryPool() {
+  if (!m_Queries.empty()) {
+    glDeleteQueries(static_cast<GLsizei>(m_Queries.size()), m_Queries.data());
+  }
+}
+
+void OpenGLTimerQueryPool::WriteTimestamp(uint32_t index) {
+  glQueryCounter(m_Queries[index], GL_TIMESTAMP);
+}
+
+bool OpenGLTimerQueryPool::IsAvailable(uint32_t index) const {
+  GLint available = GL_FALSE;
+  glGetQueryObjectiv(m_Queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+  return available == GL_TRUE;
+}
+
+uint64_t OpenGLTimerQueryPool::GetTimestamp(uint32_t index) const {
+  GLuint64 timestamp = 0;
+  glGetQueryObjectui64v(m_Queries[index], GL_QUERY_RESULT, &timestamp);
+  return timestamp;
+}
+
+uint64_t OpenGLTimerQueryPool::GetCurrentTimestamp() const {
+  GLint64 timestamp = 0;
+  glGetInteger64v(GL_TIMESTAMP, &timestamp);
+  return static_cast<uint64_t>(timestamp);
+}
+}  // namespace Onyx
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <vector>
+
+#include "Onyx/Renderer/TimerQueryPool.h"
+
+namespace Onyx {
+class OpenGLTimerQueryPool final : public TimerQueryPool {
+ public:
+  explicit OpenGLTimerQueryPool(uint32_t capacity);
+  ~OpenGLTimerQueryPool() override;
+
+  bool IsSupported() const override { return !m_Queries.empty(); }
+  uint32_t GetCapacity() const override { return static_cast<uint32_t>(m_Queries.size()); }
+
+  void WriteTimestamp(uint32_t index) override;
+  bool IsAvailable(uint32_t index) const override;
+  uint64_t GetTimestamp(uint32_t index) const override;
+  uint64_t GetCurrentTimestamp() const override;
+
+ private:
+  std::vector<uint32_t> m_Queries;
+};
+}  // namespace Onyx
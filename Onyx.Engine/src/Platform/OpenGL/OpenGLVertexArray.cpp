@@ -0,0 +1,106 @@
+#include "pch.h"
+
+#include "OpenGLVertexArray.h"
+
+#include <glad/glad.h>
+
+#include "Onyx/Renderer/Renderer.h"
+#include "Platform/OpenGL/OpenGLBuffer.h"
+#include "Platform/OpenGL/OpenGLState.h"
+
+namespace Onyx {
+static GLenum ShaderDataTypeToOpenGLBaseType(ShaderDataType type) {
+  switch (type) {
+    case ShaderDataType::Float:
+    case ShaderDataType::Float2:
+    case ShaderDataType::Float3:
+    case ShaderDataType::Float4:
+    case ShaderDataType::Mat3:
+    case ShaderDataType::Mat4:
+      return GL_FLOAT;
+    case ShaderDataType::Int:
+    case ShaderDataType::Int2:
+    case ShaderDataType::Int3:
+    case ShaderDataType::Int4:
+      return GL_INT;
+    case ShaderDataType::Bool:
+      return GL_UNSIGNED_BYTE;
+    case ShaderDataType::None:
+      break;
+  }
+
+  OnyxAssert(false, "Unknown ShaderDataType!");
+  return 0;
+}
+
+OpenGLVertexArray::OpenGLVertexArray() : m_Data(new OpenGLVertexArrayData()) {
+  Renderer::Submit([data = m_Data]() { glCreateVertexArrays(1, &data->RendererID); });
+}
+
+OpenGLVertexArray::~OpenGLVertexArray() {
+  Renderer::Submit([data = m_Data]() {
+    OpenGLState::ForgetVertexArray(data->RendererID);
+    glDeleteVertexArrays(1, &data->RendererID);
+    delete data;
+  });
+}
+
+void OpenGLVertexArray::Bind() const {
+  Renderer::Submit([data = m_Data]() { OpenGLState::BindVertexArray(data->RendererID); });
+}
+
+void OpenGLVertexArray::Unbind() const {
+  Renderer::Submit([]() { OpenGLState::BindVertexArray(0); });
+}
+
+void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) {
+  const BufferLayout& layout = vertexBuffer->GetLayout();
+  OnyxAssert(!layout.GetElements().empty(), "Vertex buffer has no layout!");
+
+  const uint32_t binding = static_cast<uint32_t>(m_VertexBuffers.size());
+  OpenGLBufferData* buffer = static_cast<OpenGLVertexBuffer&>(*vertexBuffer).GetData();
+  Renderer::Submit([data = m_Data, buffer, binding, stride = layout.GetStride()]() {
+    glVertexArrayVertexBuffer(data->RendererID, binding, buffer->RendererID, 0, stride);
+  });
+
+  for (const BufferElement& element : layout) {
+    const GLenum type = ShaderDataTypeToOpenGLBaseType(element.Type);
+    const GLint components = static_cast<GLint>(element.GetComponentCount());
+    const GLboolean normalized = element.Normalized ? GL_TRUE : GL_FALSE;
+
+    // Matrices take one attribute per column.
+    uint32_t columns = 1;
+    uint32_t columnSize = 0;
+    if (element.Type == ShaderDataType::Mat3 || element.Type == ShaderDataType::Mat4) {
+      columns = element.GetComponentCount();
+      columnSize = element.Size / columns;
+    }
+
+    for (uint32_t column = 0; column < columns; ++column) {
+      const uint32_t attribute = m_AttributeIndex++;
+      const uint32_t offset = element.Offset + column * columnSize;
+      Renderer::Submit([data = m_Data, attribute, binding, components, type, normalized, offset]() {
+        glEnableVertexArrayAttrib(data->RendererID, attribute);
+        if (type == GL_FLOAT) {
+          glVertexArrayAttribFormat(data->RendererID, attribute, components, type, normalized,
+                                    offset);
+        } else {
+          glVertexArrayAttribIFormat(data->RendererID, attribute, components, type, offset);
+        }
+        glVertexArrayAttribBinding(data->RendererID, attribute, binding);
+      });
+    }
+  }
+
+  m_VertexBuffers.push_back(vertexBuffer);
+}
+
+void OpenGLVertexArray::SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) {
+  OpenGLBufferData* buffer = static_cast<OpenGLIndexBuffer&>(*indexBuffer).GetData();
+  Renderer::Submit([data = m_Data, buffer]() {
+    glVertexArrayElementBuffer(data->RendererID, buffer->RendererID);
+  });
+
+  m_IndexBuffer = indexBuffer;
+}
+}  // namespace Onyx
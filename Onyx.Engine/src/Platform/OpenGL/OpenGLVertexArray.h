@@ -0,0 +1,34 @@
+#pragma once
+
+#include <vector>
+
+#include "Onyx/Renderer/VertexArray.h"
+
+namespace Onyx {
+struct OpenGLVertexArrayData {
+  uint32_t RendererID = 0;
+};
+
+class OpenGLVertexArray : public VertexArray {
+ public:
+  OpenGLVertexArray();
+  ~OpenGLVertexArray() override;
+
+  void Bind() const override;
+  void Unbind() const override;
+
+  void AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer) override;
+  void SetIndexBuffer(const Ref<IndexBuffer>& indexBuffer) override;
+
+  const std::vector<Ref<VertexBuffer>>& GetVertexBuffers() const override {
+    return m_VertexBuffers;
+  }
+  const Ref<IndexBuffer>& GetIndexBuffer() const override { return m_IndexBuffer; }
+
+ private:
+  OpenGLVertexArrayData* m_Data;
+  uint32_t m_AttributeIndex = 0;
+  std::vector<Ref<VertexBuffer>> m_VertexBuffers;
+  Ref<IndexBuffer> m_IndexBuffer;
+};
+}  // namespace Onyx
@@ -0,0 +1,47 @@
+#include "pch.h"
+
+#include "Onyx/MappedFile.h"
+
+#ifdef ONYX_PLATFORM_WINDOWS
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+
+namespace Onyx {
+MappedFile::MappedFile(const std::string& path) {
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return;
+  }
+  m_File = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+    return;
+  }
+
+  m_Mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!m_Mapping) {
+    return;
+  }
+
+  m_Data = static_cast<const unsigned char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_Data) {
+    m_Size = static_cast<size_t>(size.QuadPart);
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (m_Data) {
+    UnmapViewOfFile(m_Data);
+  }
+  if (m_Mapping) {
+    CloseHandle(m_Mapping);
+  }
+  if (m_File) {
+    CloseHandle(m_File);
+  }
+}
+}  // namespace Onyx
+#endif /* ONYX_PLATFORM_WINDOWS */
@@ -4,9 +4,9 @@
 
 #include <GLFW/glfw3.h>
 
-#include "Onyx/Events/ApplicationEvent.h"
-#include "Onyx/Events/KeyEvent.h"
-#include "Onyx/Events/MouseEvent.h"
+#include "Onyx/Debug/Profiler.h"
+#include "Onyx/Events/EventQueue.h"
+#include "Onyx/Renderer/Renderer.h"
 #include "Onyx/Window.h"
 #include "Platform/OpenGL/OpenGLContext.h"
 
@@ -16,7 +16,7 @@ struct WindowData {
   unsigned int Width = 0;
   unsigned int Height = 0;
   bool VSync = false;
-  std::function<void(const Event&)> Callback = nullptr;
+  EventQueue Events;
 };
 
 static void GLFWError(int error, const char* description) {
@@ -29,12 +29,23 @@ Window::Window(const WindowProps& props) {
   m_Data->Height = props.Height;
 
   OnyxInfo("Creating window of size {0}x{1}", m_Data->Width, m_Data->Height);
+  if (props.Headless) {
+    OnyxWarn("Headless windows are not supported on Windows, creating a regular window instead");
+  }
 
   int init = glfwInit();
   OnyxAssert(init, "Failed to initialize GLFW");
   glfwSetErrorCallback(GLFWError);
 
+  // The renderer relies on direct state access, which is core from 4.5 on.
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 5);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
   m_Data->Window = glfwCreateWindow(m_Data->Width, m_Data->Height, props.Title, nullptr, nullptr);
+  if (!m_Data->Window) {
+    OnyxFatal("Failed to create a window with an OpenGL 4.5 core context");
+  }
+  OnyxAssert(m_Data->Window, "Failed to create window!");
 
   // Center window on the screen
   GLFWmonitor* monitor = glfwGetPrimaryMonitor();
@@ -57,36 +68,24 @@ Window::Window(const WindowProps& props) {
     data.Width = width;
     data.Height = height;
 
-    if (!data.Callback) {
-      return;
-    }
-
-    data.Callback(WindowResizedEvent(width, height));
+    data.Events.Push(QueuedEvent::WindowResized(width, height));
   });
 
   glfwSetWindowCloseCallback(m_Data->Window, [](GLFWwindow* window) {
     WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
-    if (!data.Callback) {
-      return;
-    }
-
-    data.Callback(WindowClosedEvent());
+    data.Events.Push(QueuedEvent::WindowClosed());
   });
 
   glfwSetKeyCallback(
       m_Data->Window, [](GLFWwindow* window, int key, int scancode, int action, int mods) {
         WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
-        if (!data.Callback) {
-          return;
-        }
-
         switch (action) {
           case GLFW_PRESS:
           case GLFW_REPEAT:
-            data.Callback(KeyPressedEvent(key));
+            data.Events.Push(QueuedEvent::Key(EventType::KeyPressed, key));
             break;
           case GLFW_RELEASE:
-            data.Callback(KeyReleasedEvent(key));
+            data.Events.Push(QueuedEvent::Key(EventType::KeyReleased, key));
             break;
         }
       });
@@ -94,46 +93,30 @@ Window::Window(const WindowProps& props) {
   glfwSetCharCallback(m_Data->Window, [](GLFWwindow* window, unsigned int keycode) {
     WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
 
-    if (!data.Callback) {
-      return;
-    }
-
-    data.Callback(KeyTypedEvent(keycode));
+    data.Events.Push(QueuedEvent::Key(EventType::KeyTyped, keycode));
   });
 
   glfwSetMouseButtonCallback(
       m_Data->Window, [](GLFWwindow* window, int button, int action, int mods) {
         WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
-        if (!data.Callback) {
-          return;
-        }
-
         switch (action) {
           case GLFW_PRESS:
-            data.Callback(MousePressedEvent(button));
+            data.Events.Push(QueuedEvent::Mouse(EventType::MousePressed, button));
             break;
           case GLFW_RELEASE:
-            data.Callback(MouseReleasedEvent(button));
+            data.Events.Push(QueuedEvent::Mouse(EventType::MouseReleased, button));
             break;
         }
       });
 
   glfwSetScrollCallback(m_Data->Window, [](GLFWwindow* window, double x, double y) {
     WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
-    if (!data.Callback) {
-      return;
-    }
-
-    data.Callback(MouseScrolledEvent(y));
+    data.Events.Push(QueuedEvent::MouseScrolled(y));
   });
 
   glfwSetCursorPosCallback(m_Data->Window, [](GLFWwindow* window, double x, double y) {
     WindowData& data = *reinterpret_cast<WindowData*>(glfwGetWindowUserPointer(window));
-    if (!data.Callback) {
-      return;
-    }
-
-    data.Callback(MouseMovedEvent(x, y));
+    data.Events.Push(QueuedEvent::MouseMoved(x, y));
   });
 }
 
@@ -144,11 +127,12 @@ Window::~Window() {
 }
 
 void Window::OnUpdate() {
+  ONYX_PROFILE_FUNCTION();
+
   glfwPollEvents();
-  m_Context->SwapBuffers();
 }
 
-void Window::SetCallback(std::function<void(const Event&)> func) { m_Data->Callback = func; }
+EventQueue& Window::GetEventQueue() { return m_Data->Events; }
 
 unsigned int Window::GetWidth() const { return m_Data->Width; };
 
@@ -157,13 +141,16 @@ unsigned int Window::GetHeight() const { return m_Data->Height; };
 void* Window::GetNativeHandle() const { return reinterpret_cast<void*>(m_Data->Window); }
 
 void Window::SetVSync(bool enabled) {
-  glfwSwapInterval(enabled ? 1 : 0);
+  // Swap interval applies to the thread the context is current on.
+  Renderer::Submit([enabled]() { glfwSwapInterval(enabled ? 1 : 0); });
   m_Data->VSync = enabled;
 }
 
 bool Window::IsVSync() const { return m_Data->VSync; }
 
 bool Window::CloseRequested() const { return glfwWindowShouldClose(m_Data->Window); }
+
+bool Window::IsHeadless() const { return false; }
 }  // namespace Onyx
 
 #endif /* ONYX_PLATFORM_WINDOWS */
\ No newline at end of file
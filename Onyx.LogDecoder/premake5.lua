@@ -0,0 +1,33 @@
+project "Onyx.LogDecoder"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir)
+	objdir ("%{wks.location}/obj/" .. outputdir .. "/%{prj.name}")
+
+	files {
+		"src/**.h",
+		"src/**.cpp"
+	}
+
+	includedirs {
+		"src",
+		"%{wks.location}/Onyx.Engine/src",
+		"%{IncludeDir.spdlog}"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		runtime "Release"
+		optimize "on"
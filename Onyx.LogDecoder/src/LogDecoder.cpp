@@ -0,0 +1,290 @@
+// Turns a log written by Onyx::BinaryLog back into text.
+//   Onyx.LogDecoder <log.oxbl> [output.txt]
+
+#include <spdlog/fmt/fmt.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Onyx/Debug/BinaryLogFormat.h"
+
+using Onyx::BinaryArgType;
+using Onyx::BinaryLogRecord;
+
+struct Site {
+  uint8_t Level = 0;
+  uint32_t Line = 0;
+  std::vector<BinaryArgType> Types;
+  std::string File;
+  std::string Format;
+};
+
+struct Argument {
+  BinaryArgType Type = BinaryArgType::Int;
+  uint64_t Bits = 0;
+  std::string Text;
+};
+
+class Reader {
+ public:
+  Reader(const unsigned char* data, size_t size) : m_Data(data), m_Size(size) {}
+
+  bool AtEnd() const { return m_Offset >= m_Size; }
+
+  template <typename T>
+  bool Read(T& value) {
+    if (m_Size - m_Offset < sizeof(T)) {
+      return false;
+    }
+    std::memcpy(&value, m_Data + m_Offset, sizeof(T));
+    m_Offset += sizeof(T);
+    return true;
+  }
+
+  bool ReadBytes(void* dst, size_t size) {
+    if (m_Size - m_Offset < size) {
+      return false;
+    }
+    std::memcpy(dst, m_Data + m_Offset, size);
+    m_Offset += size;
+    return true;
+  }
+
+  bool ReadString(std::string& str) {
+    uint16_t length;
+    if (!Read(length) || m_Size - m_Offset < length) {
+      return false;
+    }
+    str.assign(reinterpret_cast<const char*>(m_Data + m_Offset), length);
+    m_Offset += length;
+    return true;
+  }
+
+ private:
+  const unsigned char* m_Data;
+  size_t m_Size;
+  size_t m_Offset = 0;
+};
+
+static const char* LevelName(uint8_t level) {
+  static const char* const names[] = {"trace", "debug", "info", "warning", "error", "critical"};
+  return level < std::size(names) ? names[level] : "unknown";
+}
+
+static std::string FormatArgument(const std::string& spec, const Argument& arg) {
+  const std::string format = "{" + spec + "}";
+  switch (arg.Type) {
+    case BinaryArgType::Int: {
+      int64_t value;
+      std::memcpy(&value, &arg.Bits, sizeof(value));
+      return fmt::vformat(format, fmt::make_format_args(value));
+    }
+    case BinaryArgType::UInt: {
+      uint64_t value = arg.Bits;
+      return fmt::vformat(format, fmt::make_format_args(value));
+    }
+    case BinaryArgType::Float: {
+      double value;
+      std::memcpy(&value, &arg.Bits, sizeof(value));
+      return fmt::vformat(format, fmt::make_format_args(value));
+    }
+    case BinaryArgType::Bool: {
+      bool value = arg.Bits != 0;
+      return fmt::vformat(format, fmt::make_format_args(value));
+    }
+    case BinaryArgType::Char: {
+      char value = static_cast<char>(arg.Bits);
+      return fmt::vformat(format, fmt::make_format_args(value));
+    }
+    case BinaryArgType::String:
+      return fmt::vformat(format, fmt::make_format_args(arg.Text));
+    case BinaryArgType::Pointer: {
+      const void* value = reinterpret_cast<const void*>(static_cast<uintptr_t>(arg.Bits));
+      return fmt::vformat(format, fmt::make_format_args(value));
+    }
+  }
+  return "?";
+}
+
+// Substitutes one argument at a time, so a bad format spec only spoils its own placeholder.
+static std::string ExpandFormat(const std::string& format, const std::vector<Argument>& args) {
+  std::string out;
+  size_t next = 0;
+  for (size_t i = 0; i < format.size(); ++i) {
+    const char c = format[i];
+    if ((c == '{' || c == '}') && i + 1 < format.size() && format[i + 1] == c) {
+      out += c;
+      ++i;
+      continue;
+    }
+    if (c != '{') {
+      out += c;
+      continue;
+    }
+
+    const size_t close = format.find('}', i);
+    if (close == std::string::npos) {
+      out.append(format, i, std::string::npos);
+      break;
+    }
+
+    // An explicit index picks the argument, otherwise they are taken in order.
+    std::string field = format.substr(i + 1, close - i - 1);
+    const size_t colon = field.find(':');
+    const std::string index = field.substr(0, colon);
+    const std::string spec = colon == std::string::npos ? std::string() : field.substr(colon);
+    const size_t arg = index.empty() ? next++ : std::strtoul(index.c_str(), nullptr, 10);
+    if (arg < args.size()) {
+      try {
+        out += FormatArgument(spec, args[arg]);
+      } catch (const fmt::format_error&) {
+        out += "{" + field + "?}";
+      }
+    } else {
+      out += "{" + field + "}";
+    }
+    i = close;
+  }
+  return out;
+}
+
+static bool DecodeMessage(const std::vector<unsigned char>& payload, uint16_t thread,
+                          const std::unordered_map<uint32_t, Site>& sites, std::string& line,
+                          std::vector<Argument>& args) {
+  Reader reader(payload.data(), payload.size());
+  uint32_t id;
+  uint64_t timestamp;
+  if (!reader.Read(id) || !reader.Read(timestamp)) {
+    return false;
+  }
+  const auto site = sites.find(id);
+  if (site == sites.end()) {
+    return false;
+  }
+
+  args.resize(site->second.Types.size());
+  for (size_t i = 0; i < args.size(); ++i) {
+    Argument& arg = args[i];
+    arg.Type = site->second.Types[i];
+    arg.Bits = 0;
+    bool ok;
+    if (arg.Type == BinaryArgType::String) {
+      ok = reader.ReadString(arg.Text);
+    } else if (arg.Type == BinaryArgType::Bool || arg.Type == BinaryArgType::Char) {
+      ok = reader.ReadBytes(&arg.Bits, 1);
+    } else {
+      ok = reader.Read(arg.Bits);
+    }
+    if (!ok) {
+      return false;
+    }
+  }
+
+  line = fmt::format("[{:.6f}] [T{}] {}: {} ({}:{})\n", timestamp / 1e9, thread,
+                     LevelName(site->second.Level), ExpandFormat(site->second.Format, args),
+                     site->second.File, site->second.Line);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argc > 3) {
+    std::fprintf(stderr, "Usage: %s <log.oxbl> [output.txt]\n", argv[0]);
+    return 1;
+  }
+
+  std::ifstream file(argv[1], std::ios::binary);
+  if (!file) {
+    std::fprintf(stderr, "Failed to open '%s'\n", argv[1]);
+    return 1;
+  }
+  const std::vector<unsigned char> data((std::istreambuf_iterator<char>(file)),
+                                        std::istreambuf_iterator<char>());
+
+  FILE* out = stdout;
+  if (argc == 3) {
+    out = std::fopen(argv[2], "w");
+    if (!out) {
+      std::fprintf(stderr, "Failed to open '%s' for writing\n", argv[2]);
+      return 1;
+    }
+  }
+
+  Reader reader(data.data(), data.size());
+  uint32_t magic = 0;
+  uint32_t version = 0;
+  if (!reader.Read(magic) || !reader.Read(version) || magic != Onyx::BinaryLogMagic ||
+      version != Onyx::BinaryLogVersion) {
+    std::fprintf(stderr, "'%s' is not a binary log of version %u\n", argv[1],
+                 Onyx::BinaryLogVersion);
+    return 1;
+  }
+
+  std::unordered_map<uint32_t, Site> sites;
+  std::vector<unsigned char> payload;
+  std::vector<Argument> args;
+  std::string line;
+  size_t messages = 0;
+  size_t corrupt = 0;
+  bool truncated = false;
+  while (!reader.AtEnd() && !truncated) {
+    BinaryLogRecord record;
+    if (!reader.Read(record)) {
+      break;
+    }
+
+    if (record == BinaryLogRecord::Site) {
+      uint32_t id;
+      Site site;
+      uint8_t count;
+      truncated = !reader.Read(id) || !reader.Read(site.Level) || !reader.Read(site.Line) ||
+                  !reader.Read(count);
+      if (!truncated) {
+        site.Types.resize(count);
+        truncated = !reader.ReadBytes(site.Types.data(), count) || !reader.ReadString(site.File) ||
+                    !reader.ReadString(site.Format);
+      }
+      if (!truncated) {
+        sites[id] = std::move(site);
+      }
+    } else if (record == BinaryLogRecord::Message) {
+      uint16_t thread;
+      uint16_t size;
+      truncated = !reader.Read(thread) || !reader.Read(size);
+      if (!truncated) {
+        payload.resize(size);
+        truncated = !reader.ReadBytes(payload.data(), size);
+      }
+      if (truncated) {
+        break;
+      }
+      if (DecodeMessage(payload, thread, sites, line, args)) {
+        std::fputs(line.c_str(), out);
+        messages++;
+      } else {
+        corrupt++;
+      }
+    } else {
+      std::fprintf(stderr, "Unknown record %u, stopping\n", static_cast<unsigned>(record));
+      break;
+    }
+  }
+
+  if (truncated) {
+    std::fprintf(stderr, "Log ends in the middle of a record, it may still be being written\n");
+  }
+  if (corrupt) {
+    std::fprintf(stderr, "Skipped %zu messages that could not be decoded\n", corrupt);
+  }
+  std::fprintf(stderr, "Decoded %zu messages\n", messages);
+
+  if (out != stdout) {
+    std::fclose(out);
+  }
+  return 0;
+}
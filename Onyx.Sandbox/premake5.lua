@@ -26,14 +26,23 @@ project "Onyx.Sandbox"
 	filter "system:windows"
 		systemversion "latest"
 
+	filter "system:linux"
+		linkoptions "-Wl,-rpath,'$$ORIGIN'"
+
+	filter "options:memory-tracking"
+		defines "ONYX_MEMORY_TRACKING=1"
+
 	filter "configurations:Debug"
+		defines "ONYX_DEBUG"
 		runtime "Debug"
 		symbols "on"
 
 	filter "configurations:Release"
+		defines "ONYX_RELEASE"
 		runtime "Release"
 		optimize "on"
 
 	filter "configurations:Dist"
+		defines "ONYX_DIST"
 		runtime "Release"
 		optimize "on"
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "HandleBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Onyx/Core.h"
+#include "Onyx/Memory/HandlePool.h"
+
+namespace {
+struct Particle {
+  float Position[3] = {0.0f, 0.0f, 0.0f};
+  float Velocity[3] = {1.0f, 0.5f, 0.25f};
+  float Life = 1.0f;
+};
+
+class Stopwatch {
+ public:
+  double Lap() {
+    const auto now = std::chrono::steady_clock::now();
+    const double ms = std::chrono::duration<double, std::milli>(now - m_Start).count();
+    m_Start = now;
+    return ms;
+  }
+
+ private:
+  std::chrono::steady_clock::time_point m_Start = std::chrono::steady_clock::now();
+};
+
+void Step(Particle& particle, double& checksum) {
+  for (int i = 0; i < 3; ++i) {
+    particle.Position[i] += particle.Velocity[i] * 0.016f;
+  }
+  checksum += particle.Position[0];
+}
+}  // namespace
+
+HandleBenchmarkResults RunHandleBenchmark(uint32_t count) {
+  HandleBenchmarkResults results;
+  results.Count = count;
+
+  // Lookups go through the handles in a shuffled order, as references held by other systems
+  // would.
+  std::vector<uint32_t> order(count);
+  std::iota(order.begin(), order.end(), 0u);
+  std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+
+  {
+    Onyx::HandlePool<Particle> pool;
+    std::vector<Onyx::Handle<Particle>> handles;
+    handles.reserve(count);
+    Stopwatch watch;
+    for (uint32_t i = 0; i < count; ++i) {
+      handles.push_back(pool.Create());
+    }
+    results.Pool.CreateMs = watch.Lap();
+
+    for (Particle& particle : pool) {
+      Step(particle, results.Checksum);
+    }
+    results.Pool.IterateMs = watch.Lap();
+
+    for (const uint32_t i : order) {
+      if (Particle* particle = pool.Get(handles[i])) {
+        Step(*particle, results.Checksum);
+      }
+    }
+    results.Pool.LookupMs = watch.Lap();
+
+    std::vector<Onyx::Handle<Particle>> copies(handles.begin(), handles.end());
+    results.Pool.CopyMs = watch.Lap();
+    results.Checksum += copies.size();
+
+    for (const uint32_t i : order) {
+      pool.Release(handles[i]);
+    }
+    results.Pool.ReleaseMs = watch.Lap();
+  }
+
+  {
+    std::vector<Onyx::Ref<Particle>> refs;
+    refs.reserve(count);
+    Stopwatch watch;
+    for (uint32_t i = 0; i < count; ++i) {
+      refs.push_back(Onyx::CreateRef<Particle>());
+    }
+    results.Ref.CreateMs = watch.Lap();
+
+    for (const Onyx::Ref<Particle>& particle : refs) {
+      Step(*particle, results.Checksum);
+    }
+    results.Ref.IterateMs = watch.Lap();
+
+    for (const uint32_t i : order) {
+      if (const Onyx::Ref<Particle>& particle = refs[i]) {
+        Step(*particle, results.Checksum);
+      }
+    }
+    results.Ref.LookupMs = watch.Lap();
+
+    // Sharing a Ref is what keeps its object alive, so every copy pays for a reference count.
+    std::vector<Onyx::Ref<Particle>> copies(refs.begin(), refs.end());
+    results.Ref.CopyMs = watch.Lap();
+    results.Checksum += copies.size();
+    copies.clear();
+    watch.Lap();
+
+    for (const uint32_t i : order) {
+      refs[i].reset();
+    }
+    results.Ref.ReleaseMs = watch.Lap();
+  }
+
+  return results;
+}
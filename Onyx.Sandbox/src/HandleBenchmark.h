@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+// Times the same work on Onyx::HandlePool<T> and on Ref<T> held in a vector.
+struct HandleBenchmarkResult {
+  double CreateMs = 0.0;
+  double IterateMs = 0.0;
+  double LookupMs = 0.0;
+  double CopyMs = 0.0;
+  double ReleaseMs = 0.0;
+};
+
+struct HandleBenchmarkResults {
+  uint32_t Count = 0;
+  HandleBenchmarkResult Pool;
+  HandleBenchmarkResult Ref;
+  // Keeps the optimizer from dropping the work.
+  double Checksum = 0.0;
+};
+
+HandleBenchmarkResults RunHandleBenchmark(uint32_t count);
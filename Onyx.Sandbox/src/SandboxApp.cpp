@@ -1,13 +1,114 @@
 #include <Onyx.h>
 #include <imgui.h>
 
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "HandleBenchmark.h"
+
 class SandboxLayer : public Onyx::Layer {
  public:
+  SandboxLayer() : Layer("Sandbox") {}
+
+  void OnAttach() override {
+    // 8x8 checkerboard.
+    constexpr uint32_t size = 8;
+    uint32_t pixels[size * size];
+    for (uint32_t y = 0; y < size; ++y) {
+      for (uint32_t x = 0; x < size; ++x) {
+        pixels[y * size + x] = (x + y) % 2 ? 0xffffffff : 0xff808080;
+      }
+    }
+    m_Checkerboard = Onyx::Texture2D::Create(size, size);
+    m_Checkerboard->SetData(pixels, sizeof(pixels));
+  }
+
+  void OnDetach() override {
+    if (m_Background.IsValid()) {
+      Onyx::Application::Get().GetAssetManager().Release(m_Background);
+    }
+  }
+
+  void OnUpdate(Onyx::Timestep ts) override {
+    m_Time += ts;
+
+    Onyx::Scope<Onyx::Window>& window = Onyx::Application::Get().GetWindow();
+    if (window->GetWidth() == 0 || window->GetHeight() == 0) {
+      return;
+    }
+    const float aspect =
+        static_cast<float>(window->GetWidth()) / static_cast<float>(window->GetHeight());
+    const float extent = static_cast<float>(m_GridSize) * 0.5f;
+    const glm::mat4 projection =
+        glm::ortho(-extent * aspect, extent * aspect, -extent, extent, -1.0f, 1.0f);
+
+    // The checkerboard stands in until the background has been uploaded.
+    Onyx::Ref<Onyx::Texture2D> background =
+        Onyx::Application::Get().GetAssetManager().GetTexture(m_Background);
+    if (!background) {
+      background = m_Checkerboard;
+    }
+
+    Onyx::Renderer2D::BeginScene(projection);
+    Onyx::Renderer2D::DrawQuad({0.0f, 0.0f, -0.1f}, {extent * 2.0f, extent * 2.0f}, background,
+                               {1.0f, 1.0f, 1.0f, 0.25f});
+    for (int y = 0; y < m_GridSize; ++y) {
+      for (int x = 0; x < m_GridSize; ++x) {
+        const float u = static_cast<float>(x) / m_GridSize;
+        const float v = static_cast<float>(y) / m_GridSize;
+        const glm::vec4 color = {u, v, 0.5f + 0.5f * std::sin(m_Time + u * 6.0f), 0.75f};
+        Onyx::Renderer2D::DrawQuad({x - extent + 0.5f, y - extent + 0.5f}, {0.9f, 0.9f}, color);
+      }
+    }
+    Onyx::Renderer2D::EndScene();
+  }
+
   void OnImGuiRender() override {
     ImGui::Begin("Sandbox");
-    ImGui::Text("SandboxLayer");
+    ImGui::SliderInt("Grid size", &m_GridSize, 1, 1000);
+    const Onyx::Renderer2D::Statistics& stats = Onyx::Renderer2D::GetStats();
+    ImGui::Text("Draw calls: %u", stats.DrawCalls);
+    ImGui::Text("Quads: %u", stats.QuadCount);
+    ImGui::InputText("Background", m_BackgroundPath, sizeof(m_BackgroundPath));
+    if (ImGui::Button("Load background")) {
+      Onyx::AssetManager& assets = Onyx::Application::Get().GetAssetManager();
+      const Onyx::AssetHandle previous = m_Background;
+      m_Background = assets.LoadTexture(m_BackgroundPath);
+      if (previous.IsValid()) {
+        assets.Release(previous);
+      }
+    }
+    ImGui::Separator();
+    ImGui::SliderInt("Handles", &m_BenchmarkCount, 1000, 1000000);
+    if (ImGui::Button("Benchmark HandlePool vs Ref")) {
+      m_Benchmark = RunHandleBenchmark(static_cast<uint32_t>(m_BenchmarkCount));
+    }
+    if (m_Benchmark.Count > 0) {
+      const HandleBenchmarkResult& pool = m_Benchmark.Pool;
+      const HandleBenchmarkResult& ref = m_Benchmark.Ref;
+      ImGui::Text("%u objects (ms)   pool     ref", m_Benchmark.Count);
+      ImGui::Text("Create         %8.3f %8.3f", pool.CreateMs, ref.CreateMs);
+      ImGui::Text("Iterate        %8.3f %8.3f", pool.IterateMs, ref.IterateMs);
+      ImGui::Text("Random lookup  %8.3f %8.3f", pool.LookupMs, ref.LookupMs);
+      ImGui::Text("Copy handles   %8.3f %8.3f", pool.CopyMs, ref.CopyMs);
+      ImGui::Text("Release        %8.3f %8.3f", pool.ReleaseMs, ref.ReleaseMs);
+    }
+#if ONYX_PROFILE
+    if (ImGui::Button("Profile 120 frames") && !Onyx::Profiler::IsActive()) {
+      ONYX_PROFILE_BEGIN_SESSION("Sandbox", "SandboxProfile.json", 120);
+    }
+#endif
     ImGui::End();
   }
+
+ private:
+  Onyx::Ref<Onyx::Texture2D> m_Checkerboard;
+  Onyx::AssetHandle m_Background;
+  char m_BackgroundPath[256] = "assets/textures/background.tga";
+  int m_GridSize = 100;
+  int m_BenchmarkCount = 100000;
+  HandleBenchmarkResults m_Benchmark;
+  float m_Time = 0.0f;
 };
 
 class Sandbox : public Onyx::Application {
@@ -16,4 +117,4 @@ class Sandbox : public Onyx::Application {
   ~Sandbox() {}
 };
 
-Onyx::Application* Onyx::CreateApplication() { return new Sandbox(); }
\ No newline at end of file
+Onyx::Application* Onyx::CreateApplication() { return new Sandbox(); }
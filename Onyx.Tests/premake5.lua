@@ -0,0 +1,46 @@
+project "Onyx.Tests"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	
+	targetdir ("%{wks.location}/bin/" .. outputdir)
+	objdir ("%{wks.location}/obj/" .. outputdir .. "/%{prj.name}")
+
+	files {
+		"src/**.h",
+		"src/**.cpp"
+	}
+
+	includedirs {
+		"src",
+		"%{wks.location}/Onyx.Engine/src",
+		"%{IncludeDir.spdlog}"
+	}
+
+	links {
+		"Onyx.Engine"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "system:linux"
+		linkoptions "-Wl,-rpath,'$$ORIGIN'"
+
+	filter "options:memory-tracking"
+		defines "ONYX_MEMORY_TRACKING=1"
+
+	filter "configurations:Debug"
+		defines "ONYX_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "ONYX_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		defines "ONYX_DIST"
+		runtime "Release"
+		optimize "on"
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "Onyx/Jobs/JobSystem.h"
+#include "Onyx/Log.h"
+
+// More jobs than a single thread's pool of job slots holds, so slots have to be recycled while
+// earlier jobs are still in flight.
+static constexpr uint32_t JobCount = 10000;
+
+static int s_Failures = 0;
+
+#define Check(expr)                                                 \
+  do {                                                              \
+    if (!(expr)) {                                                  \
+      std::printf("%s:%d: %s failed\n", __FILE__, __LINE__, #expr); \
+      s_Failures++;                                                 \
+    }                                                               \
+  } while (false)
+
+static void TestParallelFor(Onyx::JobSystem& jobs) {
+  std::vector<std::atomic<uint32_t>> visits(JobCount);
+  jobs.ParallelFor(JobCount, 1, [&visits](uint32_t begin, uint32_t end) {
+    for (uint32_t i = begin; i < end; ++i) {
+      visits[i].fetch_add(1, std::memory_order_relaxed);
+    }
+  });
+
+  uint32_t visitedOnce = 0;
+  for (const std::atomic<uint32_t>& count : visits) {
+    visitedOnce += count.load() == 1 ? 1 : 0;
+  }
+  Check(visitedOnce == JobCount);
+}
+
+static void TestRun(Onyx::JobSystem& jobs) {
+  std::atomic<uint64_t> sum{0};
+  Onyx::JobCounter counter;
+  for (uint32_t i = 0; i < JobCount; ++i) {
+    jobs.Run([&sum, i]() { sum.fetch_add(i, std::memory_order_relaxed); }, &counter);
+  }
+  jobs.Wait(counter);
+  Check(sum.load() == uint64_t(JobCount) * (JobCount - 1) / 2);
+}
+
+static void TestRunFromOtherThread(Onyx::JobSystem& jobs) {
+  std::atomic<uint32_t> ran{0};
+  std::thread thread([&jobs, &ran]() {
+    Onyx::JobCounter counter;
+    for (uint32_t i = 0; i < JobCount; ++i) {
+      jobs.Run([&ran]() { ran.fetch_add(1, std::memory_order_relaxed); }, &counter);
+    }
+    jobs.Wait(counter);
+  });
+  thread.join();
+  Check(ran.load() == JobCount);
+}
+
+static void TestDependencies(Onyx::JobSystem& jobs) {
+  std::atomic<bool> first{false};
+  std::atomic<uint32_t> ranAfter{0};
+  Onyx::JobCounter gate;
+  Onyx::JobCounter counter;
+  jobs.Run([&first]() { first.store(true); }, &gate);
+  for (uint32_t i = 0; i < JobCount; ++i) {
+    jobs.Run(
+        [&first, &ranAfter]() {
+          if (first.load()) {
+            ranAfter.fetch_add(1, std::memory_order_relaxed);
+          }
+        },
+        &counter, &gate);
+  }
+  jobs.Wait(counter);
+  Check(ranAfter.load() == JobCount);
+}
+
+int main() {
+  Onyx::LogSettings settings;
+  settings.FilePath.clear();
+  settings.ConsoleLines = 0;
+  Onyx::Log::Init(settings);
+
+  {
+    Onyx::JobSystem jobs;
+    TestParallelFor(jobs);
+    TestRun(jobs);
+    TestRunFromOtherThread(jobs);
+    TestDependencies(jobs);
+  }
+
+  Onyx::Log::Shutdown();
+  if (s_Failures > 0) {
+    std::printf("%d checks failed\n", s_Failures);
+    return 1;
+  }
+  std::printf("All job system tests passed\n");
+  return 0;
+}
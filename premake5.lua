@@ -19,6 +19,11 @@ workspace "Onyx"
 		"MultiProcessorCompile"
 	}
 
+newoption {
+	trigger = "memory-tracking",
+	description = "Count allocations per subsystem and show them in the ImGui layer (not in Dist)"
+}
+
 outputdir = "%{cfg.buildcfg}-%{cfg.system}-%{cfg.architecture}"
 
 IncludeDir = {}
@@ -37,4 +42,10 @@ group "Dependencies"
 group ""
 
 include "Onyx.Engine"
-include "Onyx.Sandbox"
\ No newline at end of file
+include "Onyx.Sandbox"
+
+group "Tools"
+	include "Onyx.LogDecoder"
+group "Tests"
+	include "Onyx.Tests"
+group ""
\ No newline at end of file